@@ -23,10 +23,10 @@ int main(int /* argc */, char * /* argv */[]) {
     rootCommand.addHelpOption(true, true);
     rootCommand.setHandler([](const ParseResult &result) {
         u8info("Link directories:\n");
-        for (const auto &item : result.option("-L").allValues())
+        for (const auto &item : result.option("-L").allValuesView())
             u8info("    %s\n", item.toString().data());
         u8info("Include directories:\n");
-        for (const auto &item : result.option("-I").allValues())
+        for (const auto &item : result.option("-I").allValuesView())
             u8info("    %s\n", item.toString().data());
         return 0;
     });
@@ -47,6 +47,9 @@ namespace SysCmdLine {
         };
         using Validator = std::function<bool /* result */ (
             const std::string & /* token */, Value * /* out */, std::string * /* errorMessage */)>;
+        using BatchValidator = std::function<int /* failed index, -1 if all succeeded */ (
+            const std::string * /* tokens */, int /* count */, Value * /* out */,
+            std::string * /* errorMessage */)>;
 
         Argument();
         Argument(const std::string &name, const std::string &desc = {}, bool required = true,
@@ -85,6 +88,28 @@ namespace SysCmdLine {
         Validator validator() const;
         void setValidator(const Validator &validator);
 
+        // Validate all tokens of a multi-value argument in one call, takes precedence over
+        // the validator, the token is used if an output value is left null
+        BatchValidator batchValidator() const;
+        void setBatchValidator(const BatchValidator &batchValidator);
+
+        // Bind the argument to user storage, the parser writes converted values to the target
+        // once the parse succeeds and doesn't keep them in the parse result. A target without
+        // any value gets the default value if there is one, as the parse result would give.
+        // List targets are cleared by every successful parse, then receive all values of a
+        // multi-value argument or a repeated option.
+        void bindTo(bool &target);
+        void bindTo(int &target);
+        void bindTo(int64_t &target);
+        void bindTo(double &target);
+        void bindTo(std::string &target);
+        void bindTo(std::vector<int> &target);
+        void bindTo(std::vector<int64_t> &target);
+        void bindTo(std::vector<double> &target);
+        void bindTo(std::vector<std::string> &target);
+        bool isBound() const;
+        void unbind();
+
     public:
         inline Argument &metavar(const std::string &metavar);
         inline Argument &required(bool required = true);
@@ -92,7 +117,11 @@ namespace SysCmdLine {
         inline Argument &expect(const std::vector<Value> &expectedValues);
         SYSCMDLINE_DECL_DEPRECATED inline Argument &multi(bool multiValueEnabled = true);
         inline Argument &validate(const Validator &validator);
+        inline Argument &batch_validate(const BatchValidator &batchValidator);
         inline Argument &nargs(Number valuePolicy);
+
+        template <class T>
+        inline Argument &bind(T &target);
     };
 
     inline bool Argument::isOptional() const {
@@ -133,11 +162,22 @@ namespace SysCmdLine {
         return *this;
     }
 
+    inline Argument &Argument::batch_validate(const Argument::BatchValidator &batchValidator) {
+        setBatchValidator(batchValidator);
+        return *this;
+    }
+
     inline Argument &Argument::nargs(const Argument::Number valuePolicy) {
         setNumber(valuePolicy);
         return *this;
     }
 
+    template <class T>
+    inline Argument &Argument::bind(T &target) {
+        bindTo(target);
+        return *this;
+    }
+
     class ArgumentHolderPrivate;
 
     class SYSCMDLINE_EXPORT ArgumentHolder : public Symbol {
@@ -146,7 +186,12 @@ namespace SysCmdLine {
         std::string displayedArguments(int displayOptions) const;
 
     public:
-        inline void addArgument(const Argument &argument);
+        int argumentCount() const;
+        Argument argument(int index) const;
+
+        // Returns the argument's index, which can be passed to the index-based accessors of
+        // `ParseResult` and `OptionResult`
+        inline int addArgument(const Argument &argument);
         void addArguments(const std::vector<Argument> &arguments);
 
         using Symbol::helpText;
@@ -155,8 +200,9 @@ namespace SysCmdLine {
         ArgumentHolder(ArgumentHolderPrivate *d);
     };
 
-    inline void ArgumentHolder::addArgument(const Argument &argument) {
+    inline int ArgumentHolder::addArgument(const Argument &argument) {
         addArguments({argument});
+        return argumentCount() - 1;
     }
 
 }
@@ -53,6 +53,7 @@ namespace SysCmdLine {
         SYSCMDLINE_DECL_PRIVATE(Command)
     public:
         using Handler = std::function<int /* code */ (const ParseResult & /* result */)>;
+        using Factory = std::function<Command()>;
 
         Command();
         Command(const std::string &name, const std::string &desc = {},
@@ -65,7 +66,11 @@ namespace SysCmdLine {
         std::string name() const;
         void setName(const std::string &name);
 
-        inline void addOption(const Option &option, const std::string &group = {});
+        int optionCount() const;
+        Option option(int index) const;
+
+        // Returns the option's index, which can be passed to `ParseResult::commandOption`
+        inline int addOption(const Option &option, const std::string &group = {});
         void addOptions(const std::vector<Option> &options, const std::string &group = {});
 
         int commandCount() const;
@@ -73,6 +78,11 @@ namespace SysCmdLine {
         inline void addCommand(const Command &command);
         void addCommands(const std::vector<Command> &commands);
 
+        // The factory is called at most once, when the parser walks into the command or the
+        // command is fetched by `command()`, the name and description are known in advance
+        void addLazyCommand(const std::string &name, const std::string &desc,
+                            const Factory &factory);
+
         std::string detailedDescription() const;
         void setDetailedDescription(const std::string &detailedDescription);
 
@@ -110,8 +120,9 @@ namespace SysCmdLine {
         addCommands({command});
     }
 
-    inline void Command::addOption(const Option &option, const std::string &group) {
+    inline int Command::addOption(const Option &option, const std::string &group) {
         addOptions({option}, group);
+        return optionCount() - 1;
     }
 
     inline Command &Command::detailed(const std::string &detailedDescription) {
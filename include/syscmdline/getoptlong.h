@@ -0,0 +1,89 @@
+/****************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 SineStriker
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ ****************************************************************************/
+
+#ifndef GETOPTLONG_H
+#define GETOPTLONG_H
+
+#include <syscmdline/parser.h>
+
+namespace SysCmdLine {
+
+    class GetOptLongPrivate;
+
+    // Iterates options in the way of `getopt_long`, backed by the token index of the parser
+    class SYSCMDLINE_EXPORT GetOptLong {
+    public:
+        enum ArgumentRequirement {
+            NoArgument,
+            RequiredArgument,
+            OptionalArgument,
+        };
+
+        // Layout compatible with `struct option` of <getopt.h>
+        struct LongOption {
+            const char *name;
+            int has_arg;
+            int *flag;
+            int val;
+        };
+
+        // optstring: short option letters in the format of `getopt`
+        // longopts:  long options terminated by a zeroed entry, may be null
+        GetOptLong(const std::string &name, const char *optstring,
+                   const LongOption *longopts = nullptr);
+        ~GetOptLong();
+
+        GetOptLong(const GetOptLong &) = delete;
+        GetOptLong &operator=(const GetOptLong &) = delete;
+
+    public:
+        // The command built from the options, usable to migrate to `Parser`
+        Command command() const;
+
+        // Non-options are moved behind the options unless the optstring starts with `+` or `-`,
+        // as `getopt_long` does
+        // longindex: index of the matched long option if not null
+        // ->         option letter or value, 0 if the flag is set, 1 for non-option in `-` mode,
+        //            `?` or `:` if failed, -1 if done
+        int next(int argc, char *const argv[], int *longindex = nullptr);
+
+        // Start over at index 1
+        void reset();
+
+        const char *optarg() const;
+        int optind() const;
+        int optopt() const;
+
+        ParseResult::Error error() const;
+        std::string errorText() const;
+
+    protected:
+        GetOptLongPrivate *d_ptr;
+    };
+
+}
+
+#endif // GETOPTLONG_H
@@ -0,0 +1,55 @@
+/****************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 SineStriker
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ ****************************************************************************/
+
+#ifndef JSONSCHEMA_H
+#define JSONSCHEMA_H
+
+#include <syscmdline/schemacache.h>
+
+namespace SysCmdLine {
+
+    // Builds a command tree from a JSON document in one pass. A command is an object with
+    // "name", "description", "detailedDescription", "version", "arguments", "options",
+    // "commands" and "catalogue" ({"arguments"|"options"|"commands": {name: [items]}}).
+    // An option has "token" or "tokens", "description", "required", "role", "shortMatch",
+    // "prior", "global", "maxOccurrence", "group" and "arguments". An argument has "name",
+    // "description", "displayName", "required", "default", "expectedValues" and "number".
+    // Enumerations are written as the enumerator names, such as "ShortMatchAll", unknown keys
+    // are ignored.
+    class SYSCMDLINE_EXPORT JsonSchema {
+    public:
+        // errorMessage: line, column and reason if failed
+        static bool load(const std::string &json, Command *command,
+                         std::string *errorMessage = nullptr,
+                         const SchemaCache::HandlerProvider &handlerProvider = {});
+        static bool loadFile(const std::string &path, Command *command,
+                             std::string *errorMessage = nullptr,
+                             const SchemaCache::HandlerProvider &handlerProvider = {});
+    };
+
+}
+
+#endif // JSONSCHEMA_H
@@ -101,6 +101,12 @@ namespace SysCmdLine {
         void setMaxOccurrence(int max);
         inline void setUnlimitedOccurrence();
 
+        // Bind the option to a flag, the parser sets the flag if the option occurs and the
+        // parse succeeds
+        void bindTo(bool &isSet);
+        bool isBound() const;
+        void unbind();
+
     public:
         inline Option &arg(const std::string &name, bool required = true,
                            const Value &defaultValue = {});
@@ -110,6 +116,7 @@ namespace SysCmdLine {
         inline Option &prior(PriorLevel priorLevel);
         inline Option &global(bool global = true);
         inline Option &multi(int maxOccurrence = 0);
+        inline Option &bind(bool &isSet);
     };
 
     inline Option::Option(std::initializer_list<std::string> tokens, const std::string &desc,
@@ -173,6 +180,11 @@ namespace SysCmdLine {
         return *this;
     }
 
+    inline Option &Option::bind(bool &isSet) {
+        bindTo(isSet);
+        return *this;
+    }
+
 }
 
 #endif // OPTION_H
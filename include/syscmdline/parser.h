@@ -48,6 +48,8 @@ namespace SysCmdLine {
             AllowDosShortOptions = 0x8,
             DontAllowUnixShortOptions = 0x10,
             EnableResponseFile = 0x20,
+            IgnoreValueCase = 0x40,
+            CollectAllErrors = 0x80,
         };
 
         enum DisplayOption {
@@ -78,6 +80,12 @@ namespace SysCmdLine {
         Command rootCommand() const;
         void setRootCommand(const Command &rootCommand);
 
+        // Check tokens of a multi-value argument in multiple threads if there are at least
+        // so many of them (never less than 4096), the validators must be thread-safe and
+        // an exception thrown by one is rethrown by `parse`, 0 to disable
+        int parallelThreshold() const;
+        void setParallelThreshold(int threshold);
+
         ParseResult parse(const std::vector<std::string> &args, int parseOptions = Standard);
         inline int invoke(const std::vector<std::string> &args, int errCode = -1,
                           int parseOptions = Standard);
@@ -87,6 +95,32 @@ namespace SysCmdLine {
         inline ParseResult parse(int argc, char **argv, int parseOptions = Standard);
         inline int invoke(int argc, char **argv, int errCode = -1, int parseOptions = Standard);
 
+    public:
+        // Receives symbols as they are recognized by `parseEvents`
+        class SYSCMDLINE_EXPORT Visitor {
+        public:
+            virtual ~Visitor() = default;
+
+            // Each command along the path, the root command first
+            virtual void onCommand(const Command &command);
+
+            // occurrence: occurrence index of the option, counts from 0
+            virtual void onOption(const Option &option, int occurrence);
+
+            // option: owner of the argument, null if it's an argument of the command
+            // The values of the arguments behind a multi-value argument are reported at last
+            virtual void onArgument(const Argument &argument, const Value &value,
+                                    const Option *option);
+
+            // token: token causing the error, may be empty
+            virtual void onError(ParseResult::Error error, const std::string &token);
+        };
+
+        // Parse without building a result, the bound storages and flags are not written
+        // -> first error
+        ParseResult::Error parseEvents(const std::vector<std::string> &args, Visitor &visitor,
+                                       int parseOptions = Standard);
+
     public:
         using TextProvider = std::string (*)(int /* category */, int /* index */);
 
@@ -116,6 +150,28 @@ namespace SysCmdLine {
         return parse({argv, argv + argc}, parseOptions).invoke(errCode);
     }
 
+    class ParseSessionPrivate;
+
+    // Parses repeatedly with the same parser, reusing the working buffers and the last result
+    // if it is no longer referenced elsewhere, not thread-safe
+    class SYSCMDLINE_EXPORT ParseSession {
+    public:
+        explicit ParseSession(const Parser &parser);
+        ~ParseSession();
+
+        ParseSession(const ParseSession &) = delete;
+        ParseSession &operator=(const ParseSession &) = delete;
+
+    public:
+        Parser parser() const;
+
+        ParseResult parse(const std::vector<std::string> &args,
+                          int parseOptions = Parser::Standard);
+
+    protected:
+        ParseSessionPrivate *d_ptr;
+    };
+
 }
 
 #endif // PARSER_H
@@ -27,6 +27,8 @@
 #ifndef PARSERESULT_H
 #define PARSERESULT_H
 
+#include <iterator>
+
 #include <syscmdline/command.h>
 
 namespace SysCmdLine {
@@ -35,6 +37,138 @@ namespace SysCmdLine {
 
     class ParseResultPrivate;
 
+    // Read-only view over the values of an argument across all occurrences of an option,
+    // valid as long as the parse result is alive
+    class SYSCMDLINE_EXPORT ValueRange {
+    public:
+        class const_iterator {
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = Value;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const Value *;
+            using reference = const Value &;
+
+            inline const_iterator();
+
+            inline reference operator*() const;
+            inline pointer operator->() const;
+            inline const_iterator &operator++();
+            inline const_iterator operator++(int);
+            inline bool operator==(const const_iterator &other) const;
+            inline bool operator!=(const const_iterator &other) const;
+
+        private:
+            inline const_iterator(const std::vector<Value> *slots, int stride, int index, int count,
+                                  int n);
+            inline void skipEmpty();
+            inline const std::vector<Value> &current() const;
+
+            const std::vector<Value> *slots;
+            int stride;
+            int index;
+            int count;
+            int n;
+            size_t pos;
+
+            friend class ValueRange;
+        };
+
+        inline ValueRange();
+
+        inline const_iterator begin() const;
+        inline const_iterator end() const;
+        inline int size() const;
+        inline bool empty() const;
+
+        std::vector<Value> toVector() const;
+
+    private:
+        inline ValueRange(const std::vector<Value> *slots, int stride, int index, int count,
+                          int total);
+
+        const std::vector<Value> *slots; // occurrence * stride + index
+        int stride;
+        int index;
+        int count;
+        int total;
+
+        friend class OptionResult;
+    };
+
+    inline ValueRange::const_iterator::const_iterator()
+        : slots(nullptr), stride(0), index(0), count(0), n(0), pos(0) {
+    }
+
+    inline ValueRange::const_iterator::reference ValueRange::const_iterator::operator*() const {
+        return current()[pos];
+    }
+
+    inline ValueRange::const_iterator::pointer ValueRange::const_iterator::operator->() const {
+        return &current()[pos];
+    }
+
+    inline ValueRange::const_iterator &ValueRange::const_iterator::operator++() {
+        ++pos;
+        skipEmpty();
+        return *this;
+    }
+
+    inline ValueRange::const_iterator ValueRange::const_iterator::operator++(int) {
+        auto res = *this;
+        ++*this;
+        return res;
+    }
+
+    inline bool ValueRange::const_iterator::operator==(const const_iterator &other) const {
+        return n == other.n && pos == other.pos;
+    }
+
+    inline bool ValueRange::const_iterator::operator!=(const const_iterator &other) const {
+        return !(*this == other);
+    }
+
+    inline ValueRange::const_iterator::const_iterator(const std::vector<Value> *slots, int stride,
+                                                      int index, int count, int n)
+        : slots(slots), stride(stride), index(index), count(count), n(n), pos(0) {
+        skipEmpty();
+    }
+
+    inline void ValueRange::const_iterator::skipEmpty() {
+        while (n < count && pos >= current().size()) {
+            ++n;
+            pos = 0;
+        }
+    }
+
+    inline const std::vector<Value> &ValueRange::const_iterator::current() const {
+        return slots[size_t(n) * stride + index];
+    }
+
+    inline ValueRange::ValueRange() : slots(nullptr), stride(0), index(0), count(0), total(0) {
+    }
+
+    inline ValueRange::const_iterator ValueRange::begin() const {
+        return {slots, stride, index, count, 0};
+    }
+
+    inline ValueRange::const_iterator ValueRange::end() const {
+        return {slots, stride, index, count, count};
+    }
+
+    inline int ValueRange::size() const {
+        return total;
+    }
+
+    inline bool ValueRange::empty() const {
+        return total == 0;
+    }
+
+    inline ValueRange::ValueRange(const std::vector<Value> *slots, int stride, int index,
+                                  int count, int total)
+        : slots(slots), stride(stride), index(index), count(count), total(total) {
+    }
+
     class SYSCMDLINE_EXPORT OptionResult {
     public:
         OptionResult();
@@ -54,6 +188,16 @@ namespace SysCmdLine {
         inline std::vector<Value> allValues(const std::string &name) const;
         std::vector<Value> allValues(int index = 0) const;
 
+        // Iterate all values of an argument without copying
+        inline ValueRange allValuesView(const Argument &arg) const;
+        inline ValueRange allValuesView(const std::string &name) const;
+        ValueRange allValuesView(int index = 0) const;
+
+        // Get number of values of an argument across all occurrences
+        inline int totalCount(const Argument &arg) const;
+        inline int totalCount(const std::string &name) const;
+        int totalCount(int index = 0) const;
+
         // Get values of multi-value argument at the option's N-th occurrence
         inline const std::vector<Value> &values(const Argument &arg, int n = 0) const;
         inline const std::vector<Value> &values(const std::string &name, int n = 0) const;
@@ -64,6 +208,11 @@ namespace SysCmdLine {
         inline Value value(const std::string &name, int n = 0) const;
         Value value(int index = 0, int n = 0) const;
 
+        // Get index of the value in the argument's expected values, -1 if not present
+        inline int ordinal(const Argument &arg, int n = 0) const;
+        inline int ordinal(const std::string &name, int n = 0) const;
+        int ordinal(int index = 0, int n = 0) const;
+
     private:
         inline OptionResult(const void *data);
         const void *data;
@@ -95,6 +244,22 @@ namespace SysCmdLine {
         return allValues(indexOf(name));
     }
 
+    inline ValueRange OptionResult::allValuesView(const Argument &arg) const {
+        return allValuesView(indexOf(arg.name()));
+    }
+
+    inline ValueRange OptionResult::allValuesView(const std::string &name) const {
+        return allValuesView(indexOf(name));
+    }
+
+    inline int OptionResult::totalCount(const Argument &arg) const {
+        return totalCount(indexOf(arg.name()));
+    }
+
+    inline int OptionResult::totalCount(const std::string &name) const {
+        return totalCount(indexOf(name));
+    }
+
     inline const std::vector<Value> &OptionResult::values(const Argument &arg, int n) const {
         return values(indexOf(arg.name()), n);
     }
@@ -111,6 +276,14 @@ namespace SysCmdLine {
         return value(indexOf(name), n);
     }
 
+    inline int OptionResult::ordinal(const Argument &arg, int n) const {
+        return ordinal(indexOf(arg.name()), n);
+    }
+
+    inline int OptionResult::ordinal(const std::string &name, int n) const {
+        return ordinal(indexOf(name), n);
+    }
+
     inline OptionResult::OptionResult(const void *data) : data(data) {
     }
 
@@ -153,6 +326,11 @@ namespace SysCmdLine {
         std::string correctionText() const;
         std::string cancellationToken() const;
 
+        // All errors if parsed with `Parser::CollectAllErrors`, otherwise at most one
+        int errorCount() const;
+        Error errorAt(int index) const;
+        std::string errorTextAt(int index) const;
+
         Command command() const;
         std::vector<Option> globalOptions() const;
         std::vector<int> commandIndexStack() const;
@@ -183,6 +361,11 @@ namespace SysCmdLine {
         inline Value value(const std::string &name) const;
         Value value(int index) const;
 
+        // Get index of the value in the argument's expected values, -1 if not present
+        inline int ordinal(const Argument &arg) const;
+        inline int ordinal(const std::string &name) const;
+        int ordinal(int index) const;
+
         inline bool isOptionSet(const Option &option) const;
         inline bool isOptionSet(const std::string &token) const;
         inline bool isOptionSet(int index) const;
@@ -192,6 +375,14 @@ namespace SysCmdLine {
         inline OptionResult option(const std::string &token) const;
         OptionResult option(int index) const;
 
+        // Detailed result for an option of the target command, `index` is the value returned
+        // by `Command::addOption`; global options inherited from a parent aren't reachable
+        OptionResult commandOption(int index) const;
+
+        // Detailed result for an option added to the root command, which also reaches its
+        // global options from a sub-command; an empty result if the option isn't inherited
+        OptionResult rootOption(int index) const;
+
         // Get value of single-value argument of given option or its default value
         inline Value valueForOption(const Option &option) const;
         inline Value valueForOption(const std::string &token) const;
@@ -200,6 +391,7 @@ namespace SysCmdLine {
     protected:
         ParseResult(ParseResultPrivate *d);
         friend class Parser;
+        friend class ParseSession;
     };
 
     inline bool ParseResult::isValid() const {
@@ -242,6 +434,14 @@ namespace SysCmdLine {
         return value(indexOfArgument(name));
     }
 
+    inline int ParseResult::ordinal(const Argument &arg) const {
+        return ordinal(indexOfArgument(arg.name()));
+    }
+
+    inline int ParseResult::ordinal(const std::string &name) const {
+        return ordinal(indexOfArgument(name));
+    }
+
     inline bool ParseResult::isOptionSet(const Option &option) const {
         return this->option(indexOfOption(option.token())).count() > 0;
     }
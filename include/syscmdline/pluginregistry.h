@@ -0,0 +1,55 @@
+/****************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 SineStriker
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ ****************************************************************************/
+
+
+#ifndef PLUGINREGISTRY_H
+#define PLUGINREGISTRY_H
+
+#include <syscmdline/command.h>
+
+namespace SysCmdLine {
+
+    // Adds the plugins listed in "plugins.json" of a directory as lazy sub-commands, the
+    // directory is read once and a plugin library is only opened when its command is reached.
+    // The manifest is {"plugins": [{"name", "description", "library", "entry"}]}, where
+    // "library" is relative to the directory and "entry" is "syscmdline_plugin_command" by
+    // default. The entry is an `extern "C"` function of type `Entry` and fills the command,
+    // whose name and description are taken from the manifest. A plugin must be built against
+    // the same syscmdline as the host. Libraries are never unloaded, since the handlers live
+    // in them.
+    class SYSCMDLINE_EXPORT PluginRegistry {
+    public:
+        using Entry = void (*)(Command *command);
+
+        // errorMessage: reason if the manifest can't be read or names a command twice, nothing
+        // is added then
+        static bool scan(const std::string &dir, Command *command,
+                         std::string *errorMessage = nullptr);
+    };
+
+}
+
+#endif // PLUGINREGISTRY_H
@@ -0,0 +1,58 @@
+/****************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 SineStriker
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ ****************************************************************************/
+
+#ifndef SCHEMACACHE_H
+#define SCHEMACACHE_H
+
+#include <cstdint>
+
+#include <syscmdline/command.h>
+
+namespace SysCmdLine {
+
+    // Stores a built command tree in a binary image to skip building it at startup, the
+    // handlers, validators, bindings, help providers and help layouts are not stored
+    class SYSCMDLINE_EXPORT SchemaCache {
+    public:
+        // Returns the handler of the command at the path, the root command name first
+        using HandlerProvider =
+            std::function<Command::Handler(const std::vector<std::string> & /* path */)>;
+
+        // key: fingerprint of the schema, an image with another key is not loaded
+        static bool save(const Command &command, const std::string &path, uint64_t key);
+        static bool load(const std::string &path, uint64_t key, Command *command,
+                         const HandlerProvider &handlerProvider = {});
+
+        // A file named after the executable next to it
+        static std::string defaultPath();
+
+        // FNV-1a hash, helps to make a key from a version string
+        static uint64_t fingerprint(const std::string &s);
+    };
+
+}
+
+#endif // SCHEMACACHE_H
@@ -46,6 +46,14 @@ namespace SysCmdLine {
             String,
         };
 
+        enum ConversionError {
+            NoConversionError,
+            EmptyString,
+            InvalidCharacter,
+            OutOfRange,
+            UnsupportedType,
+        };
+
         Value(Type type = Null);
         inline Value(bool b);
         inline Value(int i);
@@ -73,6 +81,8 @@ namespace SysCmdLine {
         bool operator!=(const Value &other) const;
 
         static Value fromString(const std::string &s, Type type);
+        static Value fromString(const char *s, size_t size, Type type,
+                                ConversionError *error = nullptr, size_t *errorPos = nullptr);
         static std::vector<std::string> toStringList(const std::vector<Value> &values);
         static const char *typeName(Type type);
 
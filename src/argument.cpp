@@ -1,11 +1,8 @@
 #include "argument.h"
 #include "argument_p.h"
 
-#ifdef SYSCMDLINE_ENABLE_VALIDITY_CHECK
-#  include <stdexcept>
-#endif
-
 #include <algorithm>
+#include <stdexcept>
 
 #include "strings.h"
 #include "parser.h"
@@ -17,13 +14,168 @@ namespace SysCmdLine {
     ArgumentPrivate::ArgumentPrivate(std::string name, const std::string &desc, bool required,
                                      Value defaultValue)
         : SymbolPrivate(Symbol::ST_Argument, desc), name(std::move(name)), required(required),
-          defaultValue(std::move(defaultValue)), number(Argument::Single) {
+          defaultValue(std::move(defaultValue)), number(Argument::Single), bindingTarget(nullptr),
+          bindingType(Value::Null), bindingIsList(false), otherValueTypes(0), defaultOrdinal(-1) {
     }
 
     SymbolPrivate *ArgumentPrivate::clone() const {
         return new ArgumentPrivate(*this);
     }
 
+    static inline std::string otherValueKey(const Value &val) {
+        return char('0' + val.type()) + val.toString();
+    }
+
+    void ArgumentPrivate::buildExpectedValueIndexes() {
+        stringValueIndexes.clear();
+        lowerStringValueIndexes.clear();
+        otherValueIndexes.clear();
+        otherValueTypes = 0;
+
+        // Insert if absent, the first one takes effect like a linear search
+        for (size_t i = 0; i < expectedValues.size(); ++i) {
+            const auto &item = expectedValues[i];
+            switch (item.type()) {
+                case Value::Null:
+                    break;
+                case Value::String: {
+                    const auto &s = item.toString();
+                    stringValueIndexes.insert(std::make_pair(s, ele(int(i))));
+                    lowerStringValueIndexes.insert(std::make_pair(Utils::toLower(s), ele(int(i))));
+                    break;
+                }
+                default: {
+                    otherValueIndexes.insert(std::make_pair(otherValueKey(item), ele(int(i))));
+                    otherValueTypes |= 1 << item.type();
+                    break;
+                }
+            }
+        }
+        updateDefaultOrdinal();
+    }
+
+    void ArgumentPrivate::updateDefaultOrdinal() {
+        defaultOrdinal = indexOfExpectedValue(defaultValue);
+    }
+
+    int ArgumentPrivate::indexOfExpectedValue(const Value &val) const {
+        const auto &indexes = val.type() == Value::String ? stringValueIndexes : otherValueIndexes;
+        auto it = indexes.find(val.type() == Value::String ? val.toString() : otherValueKey(val));
+        if (it == indexes.end()) {
+            return -1;
+        }
+
+        // Different doubles may have the same literal
+        auto idx = it->second.i;
+        if (expectedValues[idx] == val) {
+            return idx;
+        }
+        auto it2 = std::find(expectedValues.begin(), expectedValues.end(), val);
+        return it2 == expectedValues.end() ? -1 : int(it2 - expectedValues.begin());
+    }
+
+    int ArgumentPrivate::matchExpectedValue(const std::string &token, bool ignoreCase) const {
+        int res = -1;
+        {
+            auto it = stringValueIndexes.find(token);
+            if (it != stringValueIndexes.end()) {
+                res = it->second.i;
+            } else if (ignoreCase) {
+                it = lowerStringValueIndexes.find(Utils::toLower(token));
+                if (it != lowerStringValueIndexes.end()) {
+                    res = it->second.i;
+                }
+            }
+        }
+
+        // Convert the token once for each type of other values
+        for (int type = Value::Bool; type < Value::String; ++type) {
+            if (!(otherValueTypes & (1 << type)))
+                continue;
+
+            auto val = Value::fromString(token, static_cast<Value::Type>(type));
+            if (val.type() == Value::Null)
+                continue;
+
+            auto idx = indexOfExpectedValue(val);
+            if (idx >= 0 && (res < 0 || idx < res)) {
+                res = idx;
+            }
+        }
+        return res;
+    }
+
+    void ArgumentPrivate::assignBinding(const Value &val) const {
+        // A string value comes from an argument without default value or a validator,
+        // convert it to the target type in such case
+        Value converted;
+        if (val.type() == Value::String && bindingType != Value::String) {
+            converted = Value::fromString(val.toString(), bindingType);
+        }
+        const Value &v = converted.type() != Value::Null ? converted : val;
+        switch (bindingType) {
+            case Value::Bool: {
+                bindingAs<bool>() = v.toBool();
+                break;
+            }
+            case Value::Int: {
+                if (bindingIsList) {
+                    bindingAs<std::vector<int>>().push_back(v.toInt());
+                } else {
+                    bindingAs<int>() = v.toInt();
+                }
+                break;
+            }
+            case Value::Int64: {
+                if (bindingIsList) {
+                    bindingAs<std::vector<int64_t>>().push_back(v.toInt64());
+                } else {
+                    bindingAs<int64_t>() = v.toInt64();
+                }
+                break;
+            }
+            case Value::Double: {
+                if (bindingIsList) {
+                    bindingAs<std::vector<double>>().push_back(v.toDouble());
+                } else {
+                    bindingAs<double>() = v.toDouble();
+                }
+                break;
+            }
+            case Value::String: {
+                if (bindingIsList) {
+                    bindingAs<std::vector<std::string>>().push_back(v.toString());
+                } else {
+                    bindingAs<std::string>() = v.toString();
+                }
+                break;
+            }
+            default:
+                break;
+        }
+    }
+
+    void ArgumentPrivate::clearBinding() const {
+        if (!bindingIsList)
+            return;
+        switch (bindingType) {
+            case Value::Int:
+                bindingAs<std::vector<int>>().clear();
+                break;
+            case Value::Int64:
+                bindingAs<std::vector<int64_t>>().clear();
+                break;
+            case Value::Double:
+                bindingAs<std::vector<double>>().clear();
+                break;
+            case Value::String:
+                bindingAs<std::vector<std::string>>().clear();
+                break;
+            default:
+                break;
+        }
+    }
+
     Argument::Argument() : Argument(std::string()) {
     }
 
@@ -86,7 +238,7 @@ namespace SysCmdLine {
                     appendix += " [" + textProvider(Strings::Title, Strings::ExpectedValues) +
                                 ": " + Utils::join(values, ", ") + "]";
                 }
-                return d->desc + appendix;
+                return d->desc.text() + appendix;
             }
 
             default:
@@ -134,6 +286,7 @@ namespace SysCmdLine {
     void Argument::setDefaultValue(const Value &defaultValue) {
         Q_D(Argument);
         d->defaultValue = defaultValue;
+        d->updateDefaultOrdinal();
     }
 
     const std::vector<Value> &Argument::expectedValues() const {
@@ -144,6 +297,7 @@ namespace SysCmdLine {
     void Argument::setExpectedValues(const std::vector<Value> &expectedValues) {
         Q_D(Argument);
         d->expectedValues = expectedValues;
+        d->buildExpectedValueIndexes();
     }
 
     bool Argument::multiValueEnabled() const {
@@ -176,11 +330,77 @@ namespace SysCmdLine {
         d->validator = validator;
     }
 
+    Argument::BatchValidator Argument::batchValidator() const {
+        Q_D2(Argument);
+        return d->batchValidator;
+    }
+
+    void Argument::setBatchValidator(const BatchValidator &batchValidator) {
+        Q_D(Argument);
+        d->batchValidator = batchValidator;
+    }
+
+    void Argument::bindTo(bool &target) {
+        Q_D(Argument);
+        d->setBinding(&target);
+    }
+
+    void Argument::bindTo(int &target) {
+        Q_D(Argument);
+        d->setBinding(&target);
+    }
+
+    void Argument::bindTo(int64_t &target) {
+        Q_D(Argument);
+        d->setBinding(&target);
+    }
+
+    void Argument::bindTo(double &target) {
+        Q_D(Argument);
+        d->setBinding(&target);
+    }
+
+    void Argument::bindTo(std::string &target) {
+        Q_D(Argument);
+        d->setBinding(&target);
+    }
+
+    void Argument::bindTo(std::vector<int> &target) {
+        Q_D(Argument);
+        d->setBinding(&target);
+    }
+
+    void Argument::bindTo(std::vector<int64_t> &target) {
+        Q_D(Argument);
+        d->setBinding(&target);
+    }
+
+    void Argument::bindTo(std::vector<double> &target) {
+        Q_D(Argument);
+        d->setBinding(&target);
+    }
+
+    void Argument::bindTo(std::vector<std::string> &target) {
+        Q_D(Argument);
+        d->setBinding(&target);
+    }
+
+    bool Argument::isBound() const {
+        Q_D2(Argument);
+        return d->bindingTarget != nullptr;
+    }
+
+    void Argument::unbind() {
+        Q_D(Argument);
+        d->bindingTarget = nullptr;
+        d->bindingType = Value::Null;
+        d->bindingIsList = false;
+    }
+
     ArgumentHolderPrivate::ArgumentHolderPrivate(Symbol::SymbolType type, const std::string &desc)
         : SymbolPrivate(type, desc) {
     }
 
-#ifdef SYSCMDLINE_ENABLE_VALIDITY_CHECK
     void ArgumentHolderPrivate::checkAddedArgument(const Argument &arg) const {
         const auto &d = arg.d_func();
         const auto &name = d->name;
@@ -249,11 +469,22 @@ namespace SysCmdLine {
                     throw std::runtime_error("validator is not able to handle the default value.");
                 }
             }
+
+            const auto &batchValidator = d->batchValidator;
+            if (batchValidator && defaultValue.type() != Value::Null) {
+                // Batch validator is incompatible with the default value?
+                auto token = defaultValue.toString();
+                Value val;
+                std::string errorMessage;
+                if (batchValidator(&token, 1, &val, &errorMessage) >= 0) {
+                    throw std::runtime_error(
+                        "batch validator is not able to handle the default value.");
+                }
+            }
         }
 
         // ...
     }
-#endif
 
     std::string ArgumentHolder::displayedArguments(int displayOptions) const {
         Q_D2(ArgumentHolder);
@@ -293,15 +524,29 @@ namespace SysCmdLine {
         return ss;
     }
 
+    int ArgumentHolder::argumentCount() const {
+        Q_D2(ArgumentHolder);
+        return int(d->arguments.size());
+    }
+
+    Argument ArgumentHolder::argument(int index) const {
+        Q_D2(ArgumentHolder);
+        return d->arguments[index];
+    }
+
     void ArgumentHolder::addArguments(const std::vector<Argument> &arguments) {
         Q_D(ArgumentHolder);
 
 #ifdef SYSCMDLINE_ENABLE_VALIDITY_CHECK
         for (const auto &arg : arguments) {
             d->checkAddedArgument(arg);
+            d->argumentNameIndexes[arg.name()] = ele(int(d->arguments.size()));
             d->arguments.push_back(arg);
         }
 #else
+        for (size_t i = 0; i < arguments.size(); ++i) {
+            d->argumentNameIndexes[arguments[i].name()] = ele(int(d->arguments.size() + i));
+        }
         // d->arguments.insert(d->arguments.end(), arguments.begin(), arguments.end());
         d->arguments = Utils::concatVector(d->arguments, arguments);
 #endif
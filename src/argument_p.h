@@ -1,11 +1,38 @@
 #ifndef ARGUMENT_P_H
 #define ARGUMENT_P_H
 
+#include <cassert>
+
 #include "argument.h"
 #include "symbol_p.h"
 
+#include "map_p.h"
+
 namespace SysCmdLine {
 
+    // Type of the value and whether it's a list for each type of bound storage
+    template <class T>
+    struct BindingTraits;
+
+    template <Value::Type Type, bool IsList>
+    struct BindingTraitsBase {
+        static constexpr const Value::Type type = Type;
+        static constexpr const bool isList = IsList;
+    };
+
+    template <>
+    struct BindingTraits<bool> : BindingTraitsBase<Value::Bool, false> {};
+    template <>
+    struct BindingTraits<int> : BindingTraitsBase<Value::Int, false> {};
+    template <>
+    struct BindingTraits<int64_t> : BindingTraitsBase<Value::Int64, false> {};
+    template <>
+    struct BindingTraits<double> : BindingTraitsBase<Value::Double, false> {};
+    template <>
+    struct BindingTraits<std::string> : BindingTraitsBase<Value::String, false> {};
+    template <class T>
+    struct BindingTraits<std::vector<T>> : BindingTraitsBase<BindingTraits<T>::type, true> {};
+
     class ArgumentPrivate : public SymbolPrivate {
     public:
         ArgumentPrivate(std::string name, const std::string &desc, bool required,
@@ -21,6 +48,43 @@ namespace SysCmdLine {
         std::string displayName;
         Argument::Number number;
         Argument::Validator validator;
+        Argument::BatchValidator batchValidator;
+
+        void *bindingTarget;
+        Value::Type bindingType;
+        bool bindingIsList;
+
+        // Expected value indexes, string values are keyed by themselves and others are keyed
+        // by type and literal, so that matching a token doesn't convert it for each candidate
+        GenericMap stringValueIndexes;
+        GenericMap lowerStringValueIndexes;
+        GenericMap otherValueIndexes;
+        int otherValueTypes;
+        int defaultOrdinal; // index of the default value in the expected values, -1 if none
+
+        void buildExpectedValueIndexes();
+        void updateDefaultOrdinal();
+        int indexOfExpectedValue(const Value &val) const;
+        int matchExpectedValue(const std::string &token, bool ignoreCase) const;
+
+        template <class T>
+        inline void setBinding(T *target) {
+            bindingTarget = target;
+            bindingType = target ? BindingTraits<T>::type : Value::Null;
+            bindingIsList = BindingTraits<T>::isList;
+        }
+
+        // The storage is only reached as the type it was bound with
+        template <class T>
+        inline T &bindingAs() const {
+            assert(bindingTarget && bindingType == BindingTraits<T>::type &&
+                   bindingIsList == BindingTraits<T>::isList);
+            return *static_cast<T *>(bindingTarget);
+        }
+
+        // Appends to a list target, which is cleared by `clearBinding` first
+        void assignBinding(const Value &val) const;
+        void clearBinding() const;
     };
 
     class ArgumentHolderPrivate : public SymbolPrivate {
@@ -29,10 +93,10 @@ namespace SysCmdLine {
 
     public:
         std::vector<Argument> arguments;
+        GenericMap argumentNameIndexes; // name -> index of argument
 
-#ifdef SYSCMDLINE_ENABLE_VALIDITY_CHECK
+        // Always built, the schema loaders check what they read in every configuration
         void checkAddedArgument(const Argument &arg) const;
-#endif
     };
 
 }
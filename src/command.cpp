@@ -2,14 +2,9 @@
 #include "command_p.h"
 
 #include <algorithm>
+#include <stdexcept>
 #include <utility>
 
-#ifdef SYSCMDLINE_ENABLE_VALIDITY_CHECK
-#  include <stdexcept>
-
-#  include "option_p.h"
-#endif
-
 #include "parser.h"
 #include "utils_p.h"
 #include "option_p.h"
@@ -21,6 +16,20 @@ namespace SysCmdLine {
         return new CommandCataloguePrivate(*this);
     }
 
+    void CommandCataloguePrivate::checkItems(const StringList &list) {
+        for (size_t i = 0; i < list.size(); ++i) {
+            for (size_t j = 0; j < i; ++j) {
+                if (list[i] == list[j]) {
+                    throw std::runtime_error(Utils::formatText(
+                        R"(duplicated items "%1" and "%2" in catalogue)", {
+                                                                              list[i],
+                                                                              list[j],
+                                                                          }));
+                }
+            }
+        }
+    }
+
     static void addIndexes(GenericMap &indexes, StringList &keys, const std::string &key,
                            const StringList &val) {
         auto it = indexes.find(key);
@@ -34,17 +43,7 @@ namespace SysCmdLine {
         list = Utils::concatVector(list, val);
 
 #ifdef SYSCMDLINE_ENABLE_VALIDITY_CHECK
-        for (size_t i = 0; i < list.size(); ++i) {
-            for (size_t j = 0; j < i; ++j) {
-                if (list[i] == list[j]) {
-                    throw std::runtime_error(Utils::formatText(
-                        R"(duplicated items "%1" and "%2" in catalogue)", {
-                                                                              list[i],
-                                                                              list[j],
-                                                                          }));
-                }
-            }
-        }
+        CommandCataloguePrivate::checkItems(list);
 #endif
     }
 
@@ -71,10 +70,58 @@ namespace SysCmdLine {
     }
 
     SharedBasePrivate *CommandPrivate::clone() const {
-        return new CommandPrivate(*this);
+        // The copies must not share a pending factory
+        materialize();
+        auto res = new CommandPrivate(*this);
+        res->lazy.reset();
+        return res;
+    }
+
+    void CommandPrivate::materialize() const {
+        if (!lazy)
+            return;
+        std::call_once(lazy->once, [this]() {
+            // Only the parts that the placeholder doesn't have are written, the name and
+            // description may be read by other threads concurrently
+            auto d = const_cast<CommandPrivate *>(this);
+            Command cmd = lazy->factory();
+            auto src = cmd.d_func();
+            src->materialize();
+            d->arguments = src->arguments;
+            d->argumentNameIndexes = src->argumentNameIndexes;
+            d->options = src->options;
+            d->optionGroupIds = src->optionGroupIds;
+            d->optionGroups = src->optionGroups;
+            d->commands = src->commands;
+            d->commandNameIndexes = src->commandNameIndexes;
+            d->version = src->version;
+            d->detailedDescription = src->detailedDescription;
+            d->catalogue = src->catalogue;
+            d->handler = src->handler;
+            d->helpLayout = src->helpLayout;
+            d->helpProvider = src->helpProvider;
+            lazy->factory = nullptr;
+        });
+    }
+
+    int CommandPrivate::exclusiveGroupId(const std::string &group) {
+        if (group.empty())
+            return -1;
+        for (size_t i = 0; i < optionGroups.size(); ++i) {
+            if (optionGroups[i] == group) {
+                return int(i);
+            }
+        }
+        optionGroups.push_back(group);
+        return int(optionGroups.size()) - 1;
+    }
+
+    const std::string &CommandPrivate::optionGroupName(int index) const {
+        static const std::string empty;
+        auto groupId = optionGroupIds[index];
+        return groupId < 0 ? empty : optionGroups[groupId];
     }
 
-#ifdef SYSCMDLINE_ENABLE_VALIDITY_CHECK
     void CommandPrivate::checkAddedCommand(const Command &cmd) const {
         const auto &name = cmd.name();
 
@@ -166,7 +213,7 @@ namespace SysCmdLine {
         // Inconsistent exclusive group?
         if (!exclusiveGroup.empty()) {
             for (size_t i = 0; i < options.size(); ++i) {
-                if (optionGroupNames[i] == exclusiveGroup &&
+                if (optionGroupName(int(i)) == exclusiveGroup &&
                     options[i].isRequired() != opt.isRequired()) {
                     throw std::runtime_error(
                         Utils::formatText(R"(option "%1" is %2, but exclusive group "3" isn't)",
@@ -179,7 +226,6 @@ namespace SysCmdLine {
             }
         }
     }
-#endif
 
     Command::Command() : Command({}, {}) {
     }
@@ -212,9 +258,10 @@ namespace SysCmdLine {
                     options = OptionPrivate::reorderOptions(options, *globalOptions);
                 }
                 StringList groupNames(globalOptions ? globalOptions->size() : 0);
-                // groupNames.insert(groupNames.end(), d->optionGroupNames.begin(),
-                //                   d->optionGroupNames.end());
-                groupNames = Utils::concatVector(groupNames, d->optionGroupNames);
+                groupNames.reserve(groupNames.size() + d->options.size());
+                for (size_t i = 0; i < d->options.size(); ++i) {
+                    groupNames.push_back(d->optionGroupName(int(i)));
+                }
 
                 auto textProvider = a ? reinterpret_cast<Parser::TextProvider>(a[1]) : nullptr;
                 if (!textProvider) {
@@ -230,8 +277,8 @@ namespace SysCmdLine {
                 // group name -> option subscripts (vector<int> *)
                 GenericMap exclusiveGroupIndexes = [](const CommandPrivate *d) {
                     GenericMap res;
-                    for (int i = 0; i < d->optionGroupNames.size(); ++i) {
-                        const auto &group = d->optionGroupNames[i];
+                    for (int i = 0; i < d->options.size(); ++i) {
+                        const auto &group = d->optionGroupName(i);
                         if (group.empty())
                             continue;
 
@@ -357,7 +404,7 @@ namespace SysCmdLine {
                 return d->name;
             }
             case HP_SecondColumn: {
-                return d->desc;
+                return d->desc.text();
             }
         }
         return {};
@@ -375,20 +422,31 @@ namespace SysCmdLine {
 
     void Command::addOptions(const std::vector<Option> &options, const std::string &group) {
         Q_D(Command);
+        int groupId = d->exclusiveGroupId(group);
 #ifdef SYSCMDLINE_ENABLE_VALIDITY_CHECK
         for (const auto &opt : options) {
             d->checkAddedOption(opt, group);
             d->options.push_back(opt);
-            d->optionGroupNames.push_back(group);
+            d->optionGroupIds.push_back(groupId);
         }
 #else
         // d->options.insert(d->options.end(), options.begin(), options.end());
-        // d->optionGroupNames.insert(d->optionGroupNames.end(), options.size(), group);
         d->options = Utils::concatVector(d->options, options);
-        d->optionGroupNames = Utils::concatVector(d->optionGroupNames, {options.size(), group});
+        d->optionGroupIds =
+            Utils::concatVector(d->optionGroupIds, std::vector<int>(options.size(), groupId));
 #endif
     }
 
+    int Command::optionCount() const {
+        Q_D2(Command);
+        return int(d->options.size());
+    }
+
+    Option Command::option(int index) const {
+        Q_D2(Command);
+        return d->options[index];
+    }
+
     int Command::commandCount() const {
         Q_D2(Command);
         return int(d->commands.size());
@@ -396,7 +454,9 @@ namespace SysCmdLine {
 
     Command Command::command(int index) const {
         Q_D2(Command);
-        return d->commands[index];
+        const auto &cmd = d->commands[index];
+        cmd.d_func()->materialize();
+        return cmd;
     }
 
     void Command::addCommands(const std::vector<Command> &commands) {
@@ -404,17 +464,30 @@ namespace SysCmdLine {
 #ifdef SYSCMDLINE_ENABLE_VALIDITY_CHECK
         for (const auto &cmd : commands) {
             d->checkAddedCommand(cmd);
+            d->commandNameIndexes[cmd.name()] = ele(int(d->commands.size()));
             d->commands.push_back(cmd);
         }
 #else
+        for (size_t i = 0; i < commands.size(); ++i) {
+            d->commandNameIndexes[commands[i].name()] = ele(int(d->commands.size() + i));
+        }
         // d->commands.insert(d->commands.end(), commands.begin(), commands.end());
         d->commands = Utils::concatVector(d->commands, commands);
 #endif
     }
 
+    void Command::addLazyCommand(const std::string &name, const std::string &desc,
+                                 const Factory &factory) {
+        Command cmd(name, desc);
+        auto lazy = std::make_shared<CommandPrivate::LazyFactory>();
+        lazy->factory = factory;
+        const_cast<CommandPrivate *>(cmd.d_func())->lazy = std::move(lazy);
+        addCommand(cmd);
+    }
+
     std::string Command::detailedDescription() const {
         Q_D2(Command);
-        return d->detailedDescription;
+        return d->detailedDescription.text();
     }
 
     void Command::setDetailedDescription(const std::string &detailedDescription) {
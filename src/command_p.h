@@ -1,6 +1,9 @@
 #ifndef COMMAND_P_H
 #define COMMAND_P_H
 
+#include <memory>
+#include <mutex>
+
 #include "argument_p.h"
 #include "command.h"
 
@@ -19,6 +22,9 @@ namespace SysCmdLine {
         StringList arguments;
         StringList options;
         StringList commands;
+
+        // Throws if any item is duplicated, always built for the schema loaders
+        static void checkItems(const StringList &list);
     };
 
     class CommandPrivate : public ArgumentHolderPrivate {
@@ -31,21 +37,34 @@ namespace SysCmdLine {
         std::string name;
 
         std::vector<Option> options;
-        std::vector<std::string> optionGroupNames;
+        std::vector<int> optionGroupIds;       // exclusive group id of each option, -1 if none
+        std::vector<std::string> optionGroups; // group id -> name, each name is stored once
         std::vector<Command> commands;
+        GenericMap commandNameIndexes; // name -> index of command
 
         std::string version;
-        std::string detailedDescription;
+        CompressedText detailedDescription;
         CommandCatalogue catalogue;
 
         Command::Handler handler;
-        
+
         HelpLayout helpLayout;
 
-#ifdef SYSCMDLINE_ENABLE_VALIDITY_CHECK
+        struct LazyFactory {
+            std::once_flag once;
+            Command::Factory factory;
+        };
+        std::shared_ptr<LazyFactory> lazy; // null if the command is built eagerly
+
+        // Fills the command from the factory, name and description are kept
+        void materialize() const;
+
+        int exclusiveGroupId(const std::string &group);
+        const std::string &optionGroupName(int index) const;
+
+        // Always built, the schema loaders check what they read in every configuration
         void checkAddedCommand(const Command &cmd) const;
         void checkAddedOption(const Option &opt, const std::string &exclusiveGroup) const;
-#endif
     };
 
 }
@@ -0,0 +1,170 @@
+#include "compressedtext_p.h"
+
+#include <cstdint>
+#include <cstring>
+#include <tuple>
+#include <vector>
+
+namespace SysCmdLine {
+
+    namespace {
+
+        enum Tag : char {
+            Raw = 0,
+            LZ = 1,
+        };
+
+        constexpr const size_t minMatch = 4;
+        constexpr const size_t maxMatch = 0xFFFF;
+        constexpr const size_t maxOffset = 0xFFFF;
+        constexpr const int hashBits = 12;
+
+        // Shorter texts never get smaller than the tag and the varints
+        constexpr const size_t minCompressSize = 32;
+
+        inline uint32_t hash4(const char *p) {
+            uint32_t v;
+            std::memcpy(&v, p, sizeof(v));
+            return (v * 2654435761U) >> (32 - hashBits);
+        }
+
+        inline void putVarint(std::string &out, size_t v) {
+            while (v >= 0x80) {
+                out += char(v | 0x80);
+                v >>= 7;
+            }
+            out += char(v);
+        }
+
+        inline bool getVarint(const char *&p, const char *end, size_t *out) {
+            size_t v = 0;
+            for (int shift = 0; p < end && shift < 64; shift += 7) {
+                auto byte = uint8_t(*p++);
+                v |= size_t(byte & 0x7F) << shift;
+                if (!(byte & 0x80)) {
+                    *out = v;
+                    return true;
+                }
+            }
+            return false;
+        }
+
+    }
+
+    // A sequence is the literal length, the literals, the match length minus `minMatch` and
+    // the backward offset, the last sequence has no match
+    void CompressedText::assign(const std::string &text) {
+        encoded.clear();
+        if (text.empty())
+            return;
+
+        if (text.size() >= minCompressSize) {
+            std::string out;
+            out += char(LZ);
+            putVarint(out, text.size());
+
+            const char *const begin = text.data();
+            const char *const end = begin + text.size();
+            std::vector<int> table(size_t(1) << hashBits, -1);
+            const char *anchor = begin;
+            const char *p = begin;
+            while (p + minMatch <= end) {
+                auto &slot = table[hash4(p)];
+                const char *candidate = slot < 0 ? nullptr : begin + slot;
+                slot = int(p - begin);
+                if (!candidate || size_t(p - candidate) > maxOffset ||
+                    std::memcmp(candidate, p, minMatch) != 0) {
+                    ++p;
+                    continue;
+                }
+
+                size_t len = minMatch;
+                while (len < maxMatch && p + len < end && candidate[len] == p[len])
+                    ++len;
+
+                putVarint(out, size_t(p - anchor));
+                out.append(anchor, p);
+                putVarint(out, len - minMatch);
+                putVarint(out, size_t(p - candidate));
+                p += len;
+                anchor = p;
+            }
+            putVarint(out, size_t(end - anchor));
+            out.append(anchor, end);
+
+            if (out.size() < text.size() + 1) {
+                encoded = std::move(out);
+                return;
+            }
+        }
+
+        encoded.reserve(text.size() + 1);
+        encoded += char(Raw);
+        encoded += text;
+    }
+
+    std::string CompressedText::text() const {
+        // Corrupted data gives what has been decoded so far
+        std::string res;
+        std::ignore = decode(&res);
+        return res;
+    }
+
+    bool CompressedText::isValid() const {
+        return decode(nullptr);
+    }
+
+    // The data may come from a file, the size and every sequence are checked against the
+    // input left before anything is allocated or copied
+    bool CompressedText::decode(std::string *out) const {
+        if (encoded.empty())
+            return true;
+        if (encoded.front() == Raw) {
+            if (out)
+                out->assign(encoded, 1);
+            return true;
+        }
+        if (encoded.front() != LZ)
+            return false;
+
+        const char *p = encoded.data() + 1;
+        const char *const end = encoded.data() + encoded.size();
+        size_t size;
+        if (!getVarint(p, end, &size) || size / maxMatch > size_t(end - p))
+            return false;
+
+        if (out)
+            out->reserve(size);
+        size_t decoded = 0;
+        while (p < end) {
+            size_t literals;
+            if (!getVarint(p, end, &literals) || literals > size_t(end - p) ||
+                literals > size - decoded)
+                return false;
+            if (out)
+                out->append(p, literals);
+            p += literals;
+            decoded += literals;
+            if (p == end)
+                break;
+
+            size_t len, offset;
+            if (!getVarint(p, end, &len) || !getVarint(p, end, &offset) || offset == 0 ||
+                offset > decoded || len > maxMatch - minMatch ||
+                len + minMatch > size - decoded)
+                return false;
+            len += minMatch;
+
+            // The match may overlap the bytes being written
+            if (out) {
+                size_t from = decoded - offset;
+                for (size_t i = 0; i < len; ++i) {
+                    *out += (*out)[from + i];
+                }
+            }
+            decoded += len;
+        }
+        return decoded == size;
+    }
+
+}
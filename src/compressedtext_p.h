@@ -0,0 +1,51 @@
+#ifndef COMPRESSEDTEXT_P_H
+#define COMPRESSEDTEXT_P_H
+
+#include <string>
+
+namespace SysCmdLine {
+
+    // Help prose is kept encoded with a small LZ77 codec and only decoded when it's rendered,
+    // short texts that can't be shrunk are kept as they are behind a one byte tag
+    class CompressedText {
+    public:
+        CompressedText() = default;
+        CompressedText(const std::string &text) {
+            assign(text);
+        }
+
+        inline CompressedText &operator=(const std::string &text) {
+            assign(text);
+            return *this;
+        }
+
+        std::string text() const;
+
+        // Whether the data decodes to the size it declares
+        bool isValid() const;
+
+        inline bool empty() const {
+            return encoded.empty();
+        }
+
+        // The encoded bytes, which can be stored elsewhere and restored by `fromData`
+        inline const std::string &data() const {
+            return encoded;
+        }
+
+        static inline CompressedText fromData(std::string data) {
+            CompressedText res;
+            res.encoded = std::move(data);
+            return res;
+        }
+
+    protected:
+        std::string encoded;
+
+        void assign(const std::string &text);
+        bool decode(std::string *out) const;
+    };
+
+}
+
+#endif // COMPRESSEDTEXT_P_H
@@ -0,0 +1,282 @@
+#include "getoptlong.h"
+#include "getoptlong_p.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+#include "utils_p.h"
+#include "strings.h"
+#include "option_p.h"
+
+namespace SysCmdLine {
+
+    static inline bool isOptionToken(const char *token) {
+        return token[0] == '-' && token[1] != '\0';
+    }
+
+    const char *GetOptLongPrivate::takeToken(char *const argv[]) {
+        // `getopt_long` permutes the argv in place as well
+        auto args = const_cast<char **>(argv);
+        std::rotate(args + firstNonOption, args + optind, args + optind + 1);
+        optind++;
+        return args[firstNonOption++];
+    }
+
+    int GetOptLongPrivate::failed(ParseResult::Error err, const std::string &token,
+                                  int optIndex) {
+        error = {err, nullptr, nullptr, nullptr, {}, token};
+        if (err == ParseResult::MissingOptionArgument) {
+            error.option = optionTable->options[optIndex];
+            error.argument = &error.option->d_func()->arguments.front();
+            return colonOnMissing ? ':' : '?';
+        }
+        return '?';
+    }
+
+    int GetOptLongPrivate::nextLong(int argc, char *const argv[], const char *name,
+                                    int *longindex) {
+        auto eq = std::strchr(name, '=');
+        auto token = "--" + (eq ? std::string(name, eq) : std::string(name));
+
+        // Exact match, otherwise a prefix shared by one option only
+        const auto &indexes = optionTable->tokenIndexes;
+        int optIndex = -1;
+        for (auto it = indexes.lower_bound(token);
+             it != indexes.end() && Utils::starts_with(it->first, token); ++it) {
+            if (it->first.size() == token.size()) {
+                optIndex = it->second.i;
+                break;
+            }
+            if (optIndex >= 0 && optIndex != it->second.i) {
+                optopt = 0;
+                return failed(ParseResult::UnknownOption, token, -1); // ambiguous
+            }
+            optIndex = it->second.i;
+        }
+
+        int longIndex = optIndex < 0 ? -1 : optionLongIndexes[optIndex];
+        if (longIndex < 0) {
+            optopt = 0;
+            return failed(ParseResult::UnknownOption, token, -1);
+        }
+
+        const auto &entry = longOptions[longIndex];
+        optopt = entry.flag ? 0 : entry.val;
+        switch (entry.has_arg) {
+            case GetOptLong::NoArgument:
+                if (eq) {
+                    return failed(ParseResult::TooManyArguments, token, optIndex);
+                }
+                break;
+            case GetOptLong::RequiredArgument:
+                if (eq) {
+                    optarg = eq + 1;
+                } else if (optind < argc) {
+                    optarg = takeToken(argv);
+                } else {
+                    return failed(ParseResult::MissingOptionArgument, token, optIndex);
+                }
+                break;
+            default:
+                if (eq) {
+                    optarg = eq + 1;
+                }
+                break;
+        }
+
+        if (longindex) {
+            *longindex = longIndex;
+        }
+        if (entry.flag) {
+            *entry.flag = entry.val;
+            return 0;
+        }
+        return entry.val;
+    }
+
+    int GetOptLongPrivate::nextShort(int argc, char *const argv[]) {
+        auto ch = *nextChar++;
+        optopt = (unsigned char) ch;
+
+        auto requirement = shortArgs[(unsigned char) ch];
+        if (requirement < 0) {
+            return failed(ParseResult::UnknownOption, std::string("-") + ch, -1);
+        }
+
+        if (requirement == GetOptLong::NoArgument) {
+            return optopt;
+        }
+
+        // The rest of the group is the argument
+        if (*nextChar) {
+            optarg = nextChar;
+        } else if (requirement == GetOptLong::RequiredArgument) {
+            if (optind >= argc) {
+                nextChar = nullptr;
+                auto token = std::string("-") + ch;
+                return failed(ParseResult::MissingOptionArgument, token,
+                              optionTable->tokenIndexes.at(token).i);
+            }
+            optarg = takeToken(argv);
+        }
+        nextChar = nullptr;
+        return optopt;
+    }
+
+    GetOptLong::GetOptLong(const std::string &name, const char *optstring,
+                           const LongOption *longopts)
+        : d_ptr(new GetOptLongPrivate()) {
+        auto &d = *d_ptr;
+
+        switch (*optstring) {
+            case '+':
+                d.ordering = GetOptLongPrivate::RequireOrder;
+                optstring++;
+                break;
+            case '-':
+                d.ordering = GetOptLongPrivate::ReturnInOrder;
+                optstring++;
+                break;
+            default:
+                if (std::getenv("POSIXLY_CORRECT")) {
+                    d.ordering = GetOptLongPrivate::RequireOrder;
+                }
+                break;
+        }
+        if (*optstring == ':') {
+            d.colonOnMissing = true;
+            optstring++;
+        }
+
+        const auto &makeOption = [](const std::string &token, int hasArg) {
+            Option option(token);
+            if (hasArg != NoArgument) {
+                option.arg("arg", hasArg == RequiredArgument);
+            }
+            return option.multi();
+        };
+
+        // Short options
+        Command cmd(name);
+        std::fill(std::begin(d.shortArgs), std::end(d.shortArgs), -1);
+        for (auto p = optstring; *p; ++p) {
+            if (*p == ':')
+                continue;
+
+            int hasArg = NoArgument;
+            if (p[1] == ':') {
+                hasArg = (p[2] == ':') ? OptionalArgument : RequiredArgument;
+            }
+            auto &requirement = d.shortArgs[(unsigned char) *p];
+            if (requirement < 0) {
+                cmd.addOption(makeOption(std::string("-") + *p, hasArg));
+                d.optionLongIndexes.push_back(-1);
+            }
+            requirement = (signed char) hasArg;
+        }
+
+        // Long options
+        for (auto p = longopts; p && p->name; ++p) {
+            d.longOptions.push_back(*p);
+            cmd.addOption(makeOption(std::string("--") + p->name, p->has_arg));
+            d.optionLongIndexes.push_back(int(d.longOptions.size()) - 1);
+        }
+
+        d.parser.setRootCommand(cmd);
+        d.optionTable = d.parser.d_func()->optionTable({});
+    }
+
+    GetOptLong::~GetOptLong() {
+        delete d_ptr;
+    }
+
+    Command GetOptLong::command() const {
+        return d_ptr->parser.rootCommand();
+    }
+
+    int GetOptLong::next(int argc, char *const argv[], int *longindex) {
+        auto &d = *d_ptr;
+        d.optarg = nullptr;
+        d.error = {};
+
+        if (d.nextChar && *d.nextChar) {
+            return d.nextShort(argc, argv);
+        }
+        d.nextChar = nullptr;
+
+        if (d.finished) {
+            return -1;
+        }
+
+        if (d.ordering == GetOptLongPrivate::Permute) {
+            while (d.optind < argc && !isOptionToken(argv[d.optind])) {
+                d.optind++;
+            }
+        }
+        if (d.optind >= argc) {
+            d.optind = d.firstNonOption;
+            d.finished = true;
+            return -1;
+        }
+        if (!isOptionToken(argv[d.optind])) {
+            if (d.ordering == GetOptLongPrivate::RequireOrder) {
+                d.finished = true;
+                return -1;
+            }
+            d.optarg = d.takeToken(argv);
+            return 1;
+        }
+
+        auto token = d.takeToken(argv);
+        if (token[1] == '-') {
+            // The rest are all non-options
+            if (token[2] == '\0') {
+                d.optind = d.firstNonOption;
+                d.finished = true;
+                return -1;
+            }
+            return d.nextLong(argc, argv, token + 2, longindex);
+        }
+        d.nextChar = token + 1;
+        return d.nextShort(argc, argv);
+    }
+
+    void GetOptLong::reset() {
+        auto &d = *d_ptr;
+        d.optind = 1;
+        d.firstNonOption = 1;
+        d.nextChar = nullptr;
+        d.finished = false;
+        d.optarg = nullptr;
+        d.optopt = 0;
+        d.error = {};
+    }
+
+    const char *GetOptLong::optarg() const {
+        return d_ptr->optarg;
+    }
+
+    int GetOptLong::optind() const {
+        return d_ptr->optind;
+    }
+
+    int GetOptLong::optopt() const {
+        return d_ptr->optopt;
+    }
+
+    ParseResult::Error GetOptLong::error() const {
+        return d_ptr->error.error;
+    }
+
+    std::string GetOptLong::errorText() const {
+        const auto &d = *d_ptr;
+        if (d.error.error == ParseResult::NoError) {
+            return {};
+        }
+        const auto &parserData = d.parser.d_func();
+        return Utils::formatText(parserData->textProvider(Strings::ParseError, d.error.error),
+                                 d.error.placeholders(parserData->displayOptions));
+    }
+
+}
@@ -0,0 +1,46 @@
+#ifndef GETOPTLONG_P_H
+#define GETOPTLONG_P_H
+
+#include "getoptlong.h"
+#include "parser_p.h"
+#include "parseresult_p.h"
+
+namespace SysCmdLine {
+
+    class GetOptLongPrivate {
+    public:
+        enum Ordering {
+            Permute,
+            RequireOrder,  // `+` or POSIXLY_CORRECT, stop at the first non-option
+            ReturnInOrder, // `-`, report non-options as arguments of option 1
+        };
+
+        Parser parser;
+        std::shared_ptr<const OptionTable> optionTable;
+        std::vector<GetOptLong::LongOption> longOptions;
+        std::vector<int> optionLongIndexes; // option index -> long option index, -1 if none
+        signed char shortArgs[256];         // letter -> argument requirement, -1 if none
+
+        Ordering ordering = Permute;
+        bool colonOnMissing = false;
+
+        // Iteration state, non-options skipped are kept in [firstNonOption, optind)
+        int optind = 1;
+        int firstNonOption = 1;
+        const char *nextChar = nullptr; // rest of the current short option group
+        bool finished = false;
+        const char *optarg = nullptr;
+        int optopt = 0;
+        ErrorRecord error{};
+
+        // Move argv[optind] to the front of the skipped non-options
+        const char *takeToken(char *const argv[]);
+
+        int failed(ParseResult::Error err, const std::string &token, int optIndex);
+        int nextLong(int argc, char *const argv[], const char *name, int *longindex);
+        int nextShort(int argc, char *const argv[]);
+    };
+
+}
+
+#endif // GETOPTLONG_P_H
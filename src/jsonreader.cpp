@@ -0,0 +1,290 @@
+#include "jsonreader_p.h"
+
+#include <cctype>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+#include "value_p.h"
+
+namespace SysCmdLine {
+
+    void JsonReader::skipSpaces() {
+        while (p < end && (*p == ' ' || *p == '\t' || *p == '\n' || *p == '\r'))
+            ++p;
+    }
+
+    bool JsonReader::consume(char ch) {
+        skipSpaces();
+        if (p < end && *p == ch) {
+            ++p;
+            return true;
+        }
+        return false;
+    }
+
+    bool JsonReader::consumeWord(const char *word) {
+        auto len = std::strlen(word);
+        if (size_t(end - p) >= len && std::memcmp(p, word, len) == 0) {
+            p += len;
+            return true;
+        }
+        return false;
+    }
+
+    bool JsonReader::fail(const std::string &message) {
+        if (!error.empty())
+            return false;
+
+        // Report line and column of the current position
+        int line = 1, column = 1;
+        for (auto q = begin; q < p; ++q) {
+            if (*q == '\n') {
+                line++;
+                column = 1;
+            } else {
+                column++;
+            }
+        }
+        error = std::to_string(line) + ":" + std::to_string(column) + ": " + message;
+        return false;
+    }
+
+    static inline int hexDigit(char ch) {
+        if (ch >= '0' && ch <= '9')
+            return ch - '0';
+        ch |= 0x20;
+        if (ch >= 'a' && ch <= 'f')
+            return ch - 'a' + 10;
+        return -1;
+    }
+
+    static void appendUtf8(std::string &s, uint32_t cp) {
+        if (cp < 0x80) {
+            s += char(cp);
+        } else if (cp < 0x800) {
+            s += char(0xC0 | (cp >> 6));
+            s += char(0x80 | (cp & 0x3F));
+        } else if (cp < 0x10000) {
+            s += char(0xE0 | (cp >> 12));
+            s += char(0x80 | ((cp >> 6) & 0x3F));
+            s += char(0x80 | (cp & 0x3F));
+        } else {
+            s += char(0xF0 | (cp >> 18));
+            s += char(0x80 | ((cp >> 12) & 0x3F));
+            s += char(0x80 | ((cp >> 6) & 0x3F));
+            s += char(0x80 | (cp & 0x3F));
+        }
+    }
+
+    bool JsonReader::readString(std::string *out) {
+        if (!consume('"'))
+            return fail("expect string");
+
+        out->clear();
+        while (p < end) {
+            // Copy the plain run at once
+            auto q = p;
+            while (q < end && *q != '"' && *q != '\\' && uint8_t(*q) >= 0x20)
+                ++q;
+            out->append(p, q);
+            p = q;
+            if (p == end)
+                break;
+            if (uint8_t(*p) < 0x20)
+                return fail("control character in string");
+            if (*p++ == '"')
+                return true;
+
+            if (p == end)
+                break;
+            switch (char ch = *p++) {
+                case 'b':
+                    *out += '\b';
+                    break;
+                case 'f':
+                    *out += '\f';
+                    break;
+                case 'n':
+                    *out += '\n';
+                    break;
+                case 'r':
+                    *out += '\r';
+                    break;
+                case 't':
+                    *out += '\t';
+                    break;
+                case 'u': {
+                    const auto &readHex = [this](uint32_t *cp) {
+                        if (end - p < 4)
+                            return false;
+                        *cp = 0;
+                        for (int i = 0; i < 4; ++i) {
+                            auto digit = hexDigit(*p++);
+                            if (digit < 0)
+                                return false;
+                            *cp = (*cp << 4) | uint32_t(digit);
+                        }
+                        return true;
+                    };
+                    uint32_t cp;
+                    if (!readHex(&cp))
+                        return fail("invalid unicode escape");
+
+                    // Surrogate pair
+                    if (cp >= 0xD800 && cp < 0xDC00) {
+                        uint32_t low;
+                        if (!consumeWord("\\u") || !readHex(&low) || low < 0xDC00 ||
+                            low >= 0xE000)
+                            return fail("invalid surrogate pair");
+                        cp = 0x10000 + ((cp - 0xD800) << 10) + (low - 0xDC00);
+                    }
+                    appendUtf8(*out, cp);
+                    break;
+                }
+                case '"':
+                case '\\':
+                case '/':
+                    *out += ch;
+                    break;
+                default:
+                    return fail("invalid escape");
+            }
+        }
+        return fail("unterminated string");
+    }
+
+    bool JsonReader::readValue(Value *out) {
+        skipSpaces();
+        if (p == end)
+            return fail("expect value");
+
+        switch (*p) {
+            case '"': {
+                std::string s;
+                if (!readString(&s))
+                    return false;
+                *out = s;
+                return true;
+            }
+            case 't':
+            case 'f': {
+                bool b;
+                if (!readBool(&b))
+                    return false;
+                *out = b;
+                return true;
+            }
+            case 'n':
+                if (!consumeWord("null"))
+                    return fail("invalid literal");
+                *out = Value();
+                return true;
+            default:
+                break;
+        }
+
+        // -?(0|[1-9][0-9]*)(\.[0-9]+)?([eE][+-]?[0-9]+)?
+        auto q = p;
+        const auto &digits = [this, &q]() {
+            auto first = q;
+            while (q < end && *q >= '0' && *q <= '9')
+                ++q;
+            return q > first;
+        };
+        bool isInteger = true;
+        if (q < end && *q == '-')
+            ++q;
+        if (q < end && *q == '0') {
+            ++q;
+        } else if (!digits()) {
+            return fail(q == p ? "expect value" : "invalid number");
+        }
+        if (q < end && *q == '.') {
+            ++q;
+            isInteger = false;
+            if (!digits())
+                return fail("invalid number");
+        }
+        if (q < end && (*q == 'e' || *q == 'E')) {
+            ++q;
+            isInteger = false;
+            if (q < end && (*q == '+' || *q == '-'))
+                ++q;
+            if (!digits())
+                return fail("invalid number");
+        }
+        if (q < end && (std::isalnum(uint8_t(*q)) || *q == '.' || *q == '+' || *q == '-'))
+            return fail("invalid number"); // leading zeros or garbage
+
+        size_t errorPos;
+        if (isInteger) {
+            int64_t l;
+            if (parseInteger(p, q - p, std::numeric_limits<int64_t>::min(),
+                             std::numeric_limits<int64_t>::max(), &l,
+                             &errorPos) == Value::NoConversionError) {
+                p = q;
+                if (l >= std::numeric_limits<int>::min() && l <= std::numeric_limits<int>::max())
+                    *out = int(l);
+                else
+                    *out = l;
+                return true;
+            }
+        }
+        double d;
+        if (parseDouble(p, q - p, &d, &errorPos) != Value::NoConversionError)
+            return fail("invalid number");
+        p = q;
+        *out = d;
+        return true;
+    }
+
+    bool JsonReader::readBool(bool *out) {
+        skipSpaces();
+        if (consumeWord("true")) {
+            *out = true;
+            return true;
+        }
+        if (consumeWord("false")) {
+            *out = false;
+            return true;
+        }
+        return fail("expect boolean");
+    }
+
+    bool JsonReader::readInt(int *out) {
+        Value val;
+        if (!readValue(&val))
+            return false;
+        if (val.type() != Value::Int)
+            return fail("expect integer");
+        *out = val.toInt();
+        return true;
+    }
+
+    bool JsonReader::skipValue() {
+        skipSpaces();
+        if (p == end)
+            return fail("expect value");
+        switch (*p) {
+            case '{':
+                return readObject([this](const std::string &) {
+                    return skipValue(); //
+                });
+            case '[':
+                return readArray([this]() {
+                    return skipValue(); //
+                });
+            default:
+                break;
+        }
+        Value val;
+        return readValue(&val);
+    }
+
+    bool JsonReader::atEnd() {
+        skipSpaces();
+        return p == end;
+    }
+
+}
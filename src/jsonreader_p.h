@@ -0,0 +1,87 @@
+#ifndef JSONREADER_P_H
+#define JSONREADER_P_H
+
+#include <string>
+
+#include "value.h"
+
+namespace SysCmdLine {
+
+    // Minimal reader for the schema loader, values are consumed while being parsed and no
+    // document tree is built
+    class JsonReader {
+    public:
+        JsonReader(const char *data, size_t size) : p(data), begin(data), end(data + size) {
+        }
+
+        std::string error; // empty if no error
+
+        bool readString(std::string *out);
+        bool readValue(Value *out); // number, string, boolean or null
+        bool readBool(bool *out);
+        bool readInt(int *out);
+        bool skipValue();
+        bool atEnd();
+
+        // Containers nested deeper fail instead of exhausting the stack, the depth isn't
+        // restored after a failure since the reader stops at the first one
+        static constexpr const int maxDepth = 64;
+
+        // onKey(key): reads the value of the key
+        template <class F>
+        bool readObject(F &&onKey) {
+            if (!consume('{'))
+                return fail("expect object");
+            if (++depth > maxDepth)
+                return fail("too deeply nested");
+            if (consume('}'))
+                return leave();
+            std::string key;
+            do {
+                if (!readString(&key))
+                    return false;
+                if (!consume(':'))
+                    return fail("expect \":\"");
+                if (!onKey(key))
+                    return false;
+            } while (consume(','));
+            return (consume('}') || fail("expect \"}\"")) && leave();
+        }
+
+        // onItem(): reads an item
+        template <class F>
+        bool readArray(F &&onItem) {
+            if (!consume('['))
+                return fail("expect array");
+            if (++depth > maxDepth)
+                return fail("too deeply nested");
+            if (consume(']'))
+                return leave();
+            do {
+                if (!onItem())
+                    return false;
+            } while (consume(','));
+            return (consume(']') || fail("expect \"]\"")) && leave();
+        }
+
+        bool fail(const std::string &message);
+
+    protected:
+        const char *p;
+        const char *begin;
+        const char *end;
+        int depth = 0;
+
+        inline bool leave() {
+            --depth;
+            return true;
+        }
+
+        void skipSpaces();
+        bool consume(char ch);
+        bool consumeWord(const char *word);
+    };
+
+}
+
+#endif // JSONREADER_P_H
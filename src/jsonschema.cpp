@@ -0,0 +1,277 @@
+#include "jsonschema.h"
+
+#include <filesystem>
+#include <fstream>
+
+#include "jsonreader_p.h"
+#include "schemabuilder_p.h"
+#include "system.h"
+
+namespace SysCmdLine {
+
+    namespace {
+
+        const char *const role_names[] = {
+            "NoRole", "Debug", "Verbose", "Version", "Help",
+        };
+
+        const char *const prior_names[] = {
+            "NoPrior",
+            "IgnoreMissingArguments",
+            "IgnoreMissingSymbols",
+            "AutoSetWhenNoSymbols",
+            "ExclusiveToArguments",
+            "ExclusiveToOptions",
+            "ExclusiveToAll",
+        };
+
+        const char *const short_match_names[] = {
+            "NoShortMatch",
+            "ShortMatchSingleLetter",
+            "ShortMatchSingleChar",
+            "ShortMatchAll",
+        };
+
+        const char *const number_names[] = {
+            "Single",
+            "MultiValue",
+            "Remainder",
+        };
+
+        // The symbols are built in place while the document is being read
+        class JsonSchemaLoader {
+        public:
+            JsonSchemaLoader(const std::string &json) : reader(json.data(), json.size()) {
+            }
+
+            JsonReader reader;
+            std::string buffer;
+            std::string checkError; // failed check of a symbol being added
+
+            template <class T, size_t N>
+            bool readEnum(const char *const (&names)[N], T *out) {
+                if (!reader.readString(&buffer))
+                    return false;
+                for (size_t i = 0; i < N; ++i) {
+                    if (buffer == names[i]) {
+                        *out = T(i);
+                        return true;
+                    }
+                }
+                return reader.fail("unknown enumerator \"" + buffer + "\"");
+            }
+
+            bool readText(CompressedText *out) {
+                if (!reader.readString(&buffer))
+                    return false;
+                *out = buffer;
+                return true;
+            }
+
+            bool readStrings(std::vector<std::string> *out) {
+                out->clear();
+                return reader.readArray([this, out]() {
+                    return reader.readString(&out->emplace_back()); //
+                });
+            }
+
+            bool readArguments(ArgumentHolderPrivate *d) {
+                return reader.readArray([this, d]() {
+                    Argument arg;
+                    if (!readArgument(SchemaBuilder::data(arg)))
+                        return false;
+                    return SchemaBuilder::appendArgument(d, std::move(arg), &checkError) ||
+                           reader.fail(checkError);
+                });
+            }
+
+            bool readArgument(ArgumentPrivate *d) {
+                // The default value may come after the expected values
+                if (!reader.readObject([this, d](const std::string &key) {
+                        if (key == "name")
+                            return reader.readString(&d->name);
+                        if (key == "description")
+                            return readText(&d->desc);
+                        if (key == "displayName")
+                            return reader.readString(&d->displayName);
+                        if (key == "required")
+                            return reader.readBool(&d->required);
+                        if (key == "default")
+                            return reader.readValue(&d->defaultValue);
+                        if (key == "number")
+                            return readEnum(number_names, &d->number);
+                        if (key == "expectedValues") {
+                            std::vector<Value> values;
+                            if (!reader.readArray([this, &values]() {
+                                    return reader.readValue(&values.emplace_back()); //
+                                }))
+                                return false;
+                            SchemaBuilder::setExpectedValues(d, std::move(values));
+                            return true;
+                        }
+                        return reader.skipValue();
+                    }))
+                    return false;
+                d->updateDefaultOrdinal();
+                return true;
+            }
+
+            bool readOption(OptionPrivate *d, std::string *group) {
+                if (!reader.readObject([this, d, group](const std::string &key) {
+                        if (key == "token") {
+                            d->tokens.resize(1);
+                            return reader.readString(&d->tokens.front());
+                        }
+                        if (key == "tokens")
+                            return readStrings(&d->tokens);
+                        if (key == "description")
+                            return readText(&d->desc);
+                        if (key == "required")
+                            return reader.readBool(&d->required);
+                        if (key == "role")
+                            return readEnum(role_names, &d->role);
+                        if (key == "shortMatch")
+                            return readEnum(short_match_names, &d->shortMatchRule);
+                        if (key == "prior")
+                            return readEnum(prior_names, &d->priorLevel);
+                        if (key == "global")
+                            return reader.readBool(&d->global);
+                        if (key == "maxOccurrence")
+                            return reader.readInt(&d->maxOccurrence);
+                        if (key == "group")
+                            return reader.readString(group);
+                        if (key == "arguments")
+                            return readArguments(d);
+                        return reader.skipValue();
+                    }))
+                    return false;
+
+                // Same as the constructor of role option
+                if (d->tokens.empty() && d->role != Option::NoRole) {
+                    d->tokens = Option(d->role).d_func()->tokens;
+                }
+                return true;
+            }
+
+            bool readCatalogue(CommandCatalogue *catalogue) {
+                return reader.readObject([this, catalogue](const std::string &kind) {
+                    SchemaBuilder::CatalogueAdder add;
+                    if (kind == "arguments")
+                        add = &CommandCatalogue::addArguments;
+                    else if (kind == "options")
+                        add = &CommandCatalogue::addOptions;
+                    else if (kind == "commands")
+                        add = &CommandCatalogue::addCommands;
+                    else
+                        return reader.skipValue();
+
+                    std::vector<std::string> items;
+                    return reader.readObject([&](const std::string &name) {
+                        if (!readStrings(&items))
+                            return false;
+                        return SchemaBuilder::addCatalogueItems(catalogue, add, name, items,
+                                                                &checkError) ||
+                               reader.fail(checkError);
+                    });
+                });
+            }
+
+            bool readCommand(CommandPrivate *d) {
+                return reader.readObject([this, d](const std::string &key) {
+                    if (key == "name")
+                        return reader.readString(&d->name);
+                    if (key == "description")
+                        return readText(&d->desc);
+                    if (key == "detailedDescription")
+                        return readText(&d->detailedDescription);
+                    if (key == "version")
+                        return reader.readString(&d->version);
+                    if (key == "arguments")
+                        return readArguments(d);
+                    if (key == "options") {
+                        return reader.readArray([this, d]() {
+                            Option opt;
+                            std::string group;
+                            if (!readOption(SchemaBuilder::data(opt), &group))
+                                return false;
+                            return SchemaBuilder::appendOption(d, std::move(opt), group,
+                                                               &checkError) ||
+                                   reader.fail(checkError);
+                        });
+                    }
+                    if (key == "commands") {
+                        return reader.readArray([this, d]() {
+                            Command cmd;
+                            if (!readCommand(SchemaBuilder::data(cmd)))
+                                return false;
+                            return SchemaBuilder::appendCommand(d, std::move(cmd),
+                                                                &checkError) ||
+                                   reader.fail(checkError);
+                        });
+                    }
+                    if (key == "catalogue") {
+                        CommandCatalogue catalogue;
+                        if (!readCatalogue(&catalogue))
+                            return false;
+                        d->catalogue = catalogue;
+                        return true;
+                    }
+                    return reader.skipValue();
+                });
+            }
+
+            // The names may follow the sub-commands in a document, so handlers are set at last
+            static void setHandlers(CommandPrivate *d, std::vector<std::string> &path,
+                                    const SchemaCache::HandlerProvider &handlerProvider) {
+                path.push_back(d->name);
+                d->handler = handlerProvider(path);
+                for (auto &cmd : d->commands) {
+                    setHandlers(SchemaBuilder::data(cmd), path, handlerProvider);
+                }
+                path.pop_back();
+            }
+        };
+
+    }
+
+    bool JsonSchema::load(const std::string &json, Command *command, std::string *errorMessage,
+                          const SchemaCache::HandlerProvider &handlerProvider) {
+        JsonSchemaLoader loader(json);
+        Command res;
+        if (!loader.readCommand(SchemaBuilder::data(res)) ||
+            (!loader.reader.atEnd() && !loader.reader.fail("unexpected trailing characters"))) {
+            if (errorMessage)
+                *errorMessage = loader.reader.error;
+            return false;
+        }
+
+        if (handlerProvider) {
+            std::vector<std::string> path;
+            JsonSchemaLoader::setHandlers(SchemaBuilder::data(res), path, handlerProvider);
+        }
+        *command = std::move(res);
+        return true;
+    }
+
+    bool JsonSchema::loadFile(const std::string &path, Command *command,
+                              std::string *errorMessage,
+                              const SchemaCache::HandlerProvider &handlerProvider) {
+        std::ifstream file(std::filesystem::path(
+#ifdef _WIN32
+                               utf8ToWide(path)
+#else
+                               path
+#endif
+                                   ),
+                           std::ios::binary);
+        if (!file.is_open()) {
+            if (errorMessage)
+                *errorMessage = "failed to open \"" + path + "\"";
+            return false;
+        }
+        std::string json((std::istreambuf_iterator<char>(file)),
+                         std::istreambuf_iterator<char>());
+        return load(json, command, errorMessage, handlerProvider);
+    }
+
+}
@@ -32,7 +32,7 @@ namespace SysCmdLine {
                                  const std::string &desc, bool required)
         : ArgumentHolderPrivate(Symbol::ST_Option, desc), role(role), tokens(tokens),
           required(required), shortMatchRule(Option::NoShortMatch), priorLevel(Option::NoPrior),
-          global(false), maxOccurrence(1) {
+          global(false), maxOccurrence(1), flagTarget(nullptr) {
     }
 
     SymbolPrivate *OptionPrivate::clone() const {
@@ -125,7 +125,7 @@ namespace SysCmdLine {
                 }
 
                 std::string appendix;
-                std::string desc = d->desc;
+                std::string desc = d->desc.text();
                 if (desc.empty() && d->role != NoRole) {
                     desc = textProvider(Strings::OptionRole,
                                         static_cast<Strings::OptionRoleText>(d->role));
@@ -211,4 +211,19 @@ namespace SysCmdLine {
         d->maxOccurrence = max;
     }
 
+    void Option::bindTo(bool &isSet) {
+        Q_D(Option);
+        d->flagTarget = &isSet;
+    }
+
+    bool Option::isBound() const {
+        Q_D2(Option);
+        return d->flagTarget != nullptr;
+    }
+
+    void Option::unbind() {
+        Q_D(Option);
+        d->flagTarget = nullptr;
+    }
+
 }
\ No newline at end of file
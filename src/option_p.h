@@ -21,6 +21,7 @@ namespace SysCmdLine {
         Option::PriorLevel priorLevel;
         bool global;
         int maxOccurrence;
+        bool *flagTarget;
 
         static std::vector<Option> reorderOptions(const std::vector<Option> &options,
                                                   const std::vector<Option> &globalOptions);
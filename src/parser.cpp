@@ -3,8 +3,12 @@
 
 #include <cctype>
 #include <algorithm>
+#include <atomic>
+#include <exception>
 #include <filesystem>
 #include <fstream>
+#include <limits>
+#include <thread>
 
 #ifdef SYSCMDLINE_ENABLE_VALIDITY_CHECK
 
@@ -16,6 +20,7 @@
 #include "command_p.h"
 #include "option_p.h"
 #include "parseresult_p.h"
+#include "value_p.h"
 #include "system.h"
 
 namespace SysCmdLine {
@@ -70,13 +75,108 @@ namespace SysCmdLine {
     }
 
     ParserPrivate::ParserPrivate()
-        : displayOptions(Parser::Normal), textProvider(Strings::en_US::provider) {
+        : displayOptions(Parser::Normal), parallelThreshold(0),
+          textProvider(Strings::en_US::provider) {
+    }
+
+    ParserPrivate::ParserPrivate(const ParserPrivate &other)
+        : SharedBasePrivate(other), rootCommand(other.rootCommand), prologue(other.prologue),
+          epilogue(other.epilogue), displayOptions(other.displayOptions),
+          parallelThreshold(other.parallelThreshold), textProvider(other.textProvider) {
+        std::copy(std::begin(other.sizeConfig), std::end(other.sizeConfig), sizeConfig);
     }
 
     ParserPrivate *ParserPrivate::clone() const {
         return new ParserPrivate(*this);
     }
 
+    std::shared_ptr<const OptionTable>
+        ParserPrivate::optionTable(const std::vector<int> &stack) const {
+        std::lock_guard<std::mutex> lock(optionTablesMutex);
+        auto &table = optionTables[stack];
+        if (table) {
+            return table;
+        }
+
+        auto res = std::make_shared<OptionTable>();
+
+        // Collect global options along the command path
+        std::vector<const Option *> globalOptions;
+        auto cmd = &rootCommand;
+        for (const auto &index : stack) {
+            const auto &d = cmd->d_func();
+            for (const auto &option : d->options) {
+                if (option.isGlobal())
+                    globalOptions.push_back(&option);
+            }
+            cmd = &d->commands[index];
+        }
+
+        // Remove duplicated options from end to begin
+        {
+            GenericMap visitedTokens;
+            for (auto it = globalOptions.rbegin(); it != globalOptions.rend(); ++it) {
+                const auto &dd = (*it)->d_func();
+
+                bool visited = false;
+                for (const auto &token : dd->tokens) {
+                    if (Utils::contains(visitedTokens, token)) {
+                        visited = true;
+                        break;
+                    }
+                }
+
+                if (visited) {
+                    *it = nullptr; // mark invalid
+                    continue;
+                }
+
+                for (const auto &token : dd->tokens) {
+                    visitedTokens[token] = ele(size_t(0));
+                }
+            }
+        }
+
+        const auto &cmdOptions = cmd->d_func()->options;
+        res->options.reserve(globalOptions.size() + cmdOptions.size());
+        for (const auto &opt : globalOptions) {
+            if (opt)
+                res->options.push_back(opt);
+        }
+        res->globalOptionsSize = int(res->options.size());
+        for (const auto &opt : cmdOptions) {
+            res->options.push_back(&opt);
+        }
+
+        // The root's global options come first and keep their order, -1 if not inherited
+        const auto &rootOptions = rootCommand.d_func()->options;
+        res->rootOptionIndexes.assign(rootOptions.size(), -1);
+        if (stack.empty()) {
+            for (size_t i = 0; i < rootOptions.size(); ++i) {
+                res->rootOptionIndexes[i] = int(i);
+            }
+        } else {
+            int index = 0;
+            auto it = globalOptions.begin();
+            for (size_t i = 0; i < rootOptions.size(); ++i) {
+                if (rootOptions[i].isGlobal() && *it++) {
+                    res->rootOptionIndexes[i] = index++;
+                }
+            }
+        }
+
+        // Build option indexes
+        for (size_t i = 0; i < res->options.size(); ++i) {
+            for (const auto &token : res->options[i]->d_func()->tokens) {
+                res->tokenIndexes[token] = ele(int(i));
+                res->lowerTokenIndexes[Utils::toLower(token)] = ele(int(i));
+            }
+        }
+
+        table = res;
+        return table;
+    }
+
     Parser::Parser() : SharedBase(new ParserPrivate()) {
     }
 
@@ -127,36 +227,68 @@ namespace SysCmdLine {
         }
 #endif
         d->rootCommand = rootCommand;
+
+        std::lock_guard<std::mutex> lock(d->optionTablesMutex);
+        d->optionTables.clear();
+    }
+
+    int Parser::parallelThreshold() const {
+        Q_D2(Parser);
+        return d->parallelThreshold;
+    }
+
+    void Parser::setParallelThreshold(int threshold) {
+        Q_D(Parser);
+        d->parallelThreshold = threshold;
     }
 
     namespace {
 
         class ParserCore {
         public:
-            ParserCore(const std::vector<std::string> &params, int parseOptions, int displayOptions,
-                       const Command *rootCommand)
-                : params(params), parseOptions(parseOptions), displayOptions(displayOptions),
-                  rootCommand(rootCommand), result(new ParseResultPrivate()), core(result->core) {
-            }
-
-            ~ParserCore() {
-                delete[] optionRanges;
-                core.allOptionTokenIndexes = std::move(allOptionTokenIndexes);
+            ParserCore(const std::vector<std::string> &args, int parseOptions,
+                       const ParserPrivate *parserData, ParseScratch &scratch,
+                       ParseResultPrivate *result, Parser::Visitor *visitor = nullptr)
+                : params(scratch.params), parseOptions(parseOptions),
+                  collectAllErrors(parseOptions & Parser::CollectAllErrors),
+                  displayOptions(parserData->displayOptions),
+                  parallelThreshold(parserData->parallelThreshold), parserData(parserData),
+                  rootCommand(&parserData->rootCommand), result(result), core(result->core),
+                  visitor(visitor),
+                  encounteredExclusiveGroups(scratch.encounteredExclusiveGroups),
+                  requiredOptionMask(scratch.requiredOptionMask),
+                  seenOptionMask(scratch.seenOptionMask),
+                  positionalArguments(scratch.positionalArguments),
+                  tokenKinds(scratch.tokenKinds), groupFlagsResult(scratch.groupFlagsResult),
+                  pendingBindings(scratch.pendingBindings),
+                  boundArguments(scratch.boundArguments), bulkInts(scratch.bulkInts),
+                  bulkInt64s(scratch.bulkInt64s), bulkDoubles(scratch.bulkDoubles) {
+                params = args;
+                positionalArguments.clear();
+                pendingBindings.clear();
+                boundArguments.clear();
+                bulkInts.clear();
+                bulkInt64s.clear();
+                bulkDoubles.clear();
             }
 
             bool parse() {
                 searchTargetCommandAndBuildIndexes();
-                if (result->error != ParseResult::NoError) {
+                if (shouldStop()) {
                     return false;
                 }
-                extractOptionsAndArguments();
-                if (result->error != ParseResult::NoError) {
+                parseTokens();
+                if (shouldStop()) {
                     return false;
                 }
-                parseArguments();
+                finishArguments();
                 if (result->error != ParseResult::NoError) {
                     return false;
                 }
+                if (visitor) {
+                    return true; // nothing stored
+                }
+                commitBindings();
 
                 // Scan roles
                 for (int i = 0; i < core.allOptionsSize; ++i) {
@@ -206,11 +338,12 @@ namespace SysCmdLine {
             }
 
             void searchTargetCommandAndBuildIndexes() {
-                int globalOptionCount = 0;
-
                 // 1. Find target command
                 {
                     auto cmd = rootCommand;
+                    if (visitor) {
+                        visitor->onCommand(*cmd);
+                    }
                     size_t i = 1;
                     for (; i < params.size(); ++i) {
                         const auto &dd = cmd->d_func();
@@ -231,14 +364,11 @@ namespace SysCmdLine {
                         }
 
                         result->stack.push_back(int(j));
-                        globalOptionCount += [](const Command *cmd) {
-                            int cnt = 0;
-                            for (const auto &opt : cmd->d_func()->options)
-                                if (opt.isGlobal())
-                                    cnt++;
-                            return cnt;
-                        }(cmd);
                         cmd = &cmd->d_func()->commands.at(j);
+                        cmd->d_func()->materialize();
+                        if (visitor) {
+                            visitor->onCommand(*cmd);
+                        }
                     }
                     nonCommandIndex = i;
                     result->command = cmd;
@@ -252,110 +382,58 @@ namespace SysCmdLine {
                         if (readResponseFile(pathStr, lines)) {
                             params.pop_back();
                             params.insert(params.end(), lines.begin(), lines.end());
+                            paramsExpanded = true;
                         } else {
-                            buildError(ParseResult::ErrorReadingResponseFile, {pathStr}, params[i],
-                                       nullptr);
+                            buildError(ParseResult::ErrorReadingResponseFile, params[i], nullptr);
                         }
                     }
-
-                    // Build command indexes
-                    for (size_t j = 0; j < targetCommandData->commands.size(); ++j) {
-                        core.cmdNameIndexes[targetCommandData->commands[j].name()] = ele(int(j));
-                    }
                 }
 
-                // 2. Collect options along the command path
-                const auto **globalOptionList = new const Option *[globalOptionCount]; // Alloc
-                {
-                    int globalOptionListIndex = 0;
-                    auto cmd = rootCommand;
-                    for (size_t i = 0; i < result->stack.size(); ++i) {
-                        const auto &d = cmd->d_func();
-
-                        // Add options
-                        for (const auto &option : d->options) {
-                            if (!option.isGlobal())
-                                continue;
-                            globalOptionList[globalOptionListIndex++] = &option;
-                        }
-                        cmd = &d->commands[i];
-                    }
-                }
+                // 2. Get options along the command path, cached per path
+                core.optionTable = parserData->optionTable(result->stack);
+                const auto &optionTable = *core.optionTable;
 
-                // 3. Remove duplicated options from end to begin
-                int realGlobalOptionCount = globalOptionCount;
+                // 3. Alloc option spaces
                 {
-                    GenericMap visitedTokens;
-                    for (int i = globalOptionCount - 1; i >= 0; --i) {
-                        auto &opt = globalOptionList[i];
-                        const auto &dd = opt->d_func();
-
-                        bool visited = false;
-                        for (const auto &token : dd->tokens) {
-                            if (Utils::contains(visitedTokens, token)) {
-                                visited = true;
-                                break;
-                            }
-                        }
-
-                        if (visited) {
-                            realGlobalOptionCount--;
-                            opt = nullptr; // mark invalid
-                            continue;
-                        }
-
-                        for (const auto &token : dd->tokens) {
-                            visitedTokens[token] = ele(size_t(0));
-                        }
-                    }
-                }
-
-                // 4. Alloc option spaces
-                {
-                    core.allOptionsSize =
-                        realGlobalOptionCount + int(targetCommandData->options.size());
-                    core.globalOptionsSize = realGlobalOptionCount;
-                    core.allOptionsResult = new OptionData[core.allOptionsSize];
-
-                    // init options
-                    int allOptionsIndex = 0;
-                    for (int i = 0; i < globalOptionCount; ++i) {
-                        auto opt = globalOptionList[i];
-                        if (!opt)
-                            continue;
-                        initOptionData(core.allOptionsResult[allOptionsIndex++], opt);
+                    core.allOptionsSize = int(optionTable.options.size());
+                    core.globalOptionsSize = optionTable.globalOptionsSize;
+                    if (core.allOptionsResult.size() < optionTable.options.size()) {
+                        core.allOptionsResult.resize(optionTable.options.size());
                     }
-
-                    for (const auto &option : targetCommandData->options) {
-                        initOptionData(core.allOptionsResult[allOptionsIndex++], &option);
+                    for (int i = 0; i < core.allOptionsSize; ++i) {
+                        initOptionData(core.allOptionsResult[i], optionTable.options[i]);
                     }
                 }
 
-                delete[] globalOptionList; // Free
-
-                // 5. Alloc command argument space
+                // 4. Alloc command argument space
                 {
                     initArgumentHolderData(core, targetCommandData->arguments);
-                    core.argResult = new std::vector<Value>[core.argSize];
-                    for (int i = 0; i < core.argSize; ++i) {
-                        core.argResult[i].reserve(1); // most are single-value argument
+                    if (!visitor) {
+                        resetValueSlots(core.argResult, core.argSize);
+                        core.argOrdinals.assign(core.argSize, -1);
                     }
                 }
 
-                // 6. Build option indexes
-                buildOptionTokenIndexes(allOptionTokenIndexes,
-                                        [](const std::string &s) { return s; });
+                // 5. Build single-letter flag table if needed
+                if ((parseOptions & Parser::AllowUnixGroupFlags)) {
+                    buildGroupFlagTable();
+                }
 
-                // Build case-insensitive option indexes if needed
-                if ((parseOptions & Parser::IgnoreOptionCase)) {
-                    buildOptionTokenIndexes(lowerOptionTokenIndexes, [](const std::string &s) {
-                        return Utils::toLower(s); //
-                    });
+                // 6. Build constraint sets
+                requiredOptionMask.assign((core.allOptionsSize + 63) / 64, 0);
+                seenOptionMask.assign(requiredOptionMask.size(), 0);
+                for (int i = 0; i < core.allOptionsSize; ++i) {
+                    if (core.allOptionsResult[i].option->isRequired()) {
+                        requiredOptionMask[i >> 6] |= uint64_t(1) << (i & 63);
+                    }
                 }
+                encounteredExclusiveGroups.assign(targetCommandData->optionGroups.size(), -1);
             }
 
-            void extractOptionsAndArguments() {
-                optionRanges = new OptionRange[core.allOptionsSize]; // Alloc
+            // Resolve, classify and convert all tokens in one forward sweep, only the positional
+            // tokens from the multi-value argument on are kept to be matched backward at last
+            void parseTokens() {
+                classifyTokens();
 
                 struct TokenOptionResult {
                     int optIndex;
@@ -369,43 +447,58 @@ namespace SysCmdLine {
                 };
 
                 TokenOptionResult optionResult;
-                std::vector<int> groupFlagsResult;
                 TokenResultType resultType = TRT_Nothing;
 
-                const auto &tryOption = [&optionResult, this](const std::string &token) {
-                    return (optionResult.optIndex = searchOption(token, &optionResult.pos)) >= 0;
+                const auto &tryOption = [&optionResult, this](size_t i) {
+                    return (tokenKinds[i] & (TK_Dash | TK_Slash)) &&
+                           (optionResult.optIndex = searchOption(params[i], &optionResult.pos)) >=
+                               0;
                 };
 
-                const auto &tryGroupFlags = [&groupFlagsResult, this](const std::string &token) {
-                    return (parseOptions & Parser::AllowUnixGroupFlags) && isFlags(token) &&
-                           !(groupFlagsResult = searchGroupFlags(token)).empty();
+                const auto &tryGroupFlags = [this](size_t i) {
+                    return (parseOptions & Parser::AllowUnixGroupFlags) &&
+                           (tokenKinds[i] & TK_Flags) == TK_Flags && searchGroupFlags(params[i]);
                 };
 
+                const auto &cmdArgs = targetCommandData->arguments;
+                size_t forwardEnd =
+                    core.multiValueArgIndex >= 0 ? size_t(core.multiValueArgIndex) : cmdArgs.size();
+
                 for (auto i = nonCommandIndex; i < params.size(); ++i) {
                     const auto &token = params[i];
                     auto lastResultType = resultType;
                     resultType = TRT_Nothing;
 
                     // Consider option
-                    if (lastResultType == TRT_Option || tryOption(token)) {
+                    if (lastResultType == TRT_Option || tryOption(i)) {
                         auto optIndex = optionResult.optIndex;
                         auto pos = optionResult.pos;
 
-                        const auto &optData = core.allOptionsResult[optIndex];
+                        auto &optData = core.allOptionsResult[optIndex];
                         const auto &opt = optData.option;
-                        auto &rangeData = optionRanges[optIndex];
 
-                        // Check option common
-                        if (!checkOptionCommon(token, optIndex, rangeData.size())) {
+                        // Check option common, keep going to collect more errors if required
+                        if (!checkOptionCommon(token, optIndex, optData.count) &&
+                            !collectAllErrors) {
                             break;
                         }
 
                         const auto &dd = opt->d_func();
 
-                        // Collect positional arguments
+                        // Convert option arguments
                         if (pos >= 0) {
                             // Must be a single value option
-                            rangeData.push(int(i), 0, token.substr(pos));
+                            auto resVec = addOccurrence(optData);
+                            if (size_t(pos) < token.size()) {
+                                const auto &arg = dd->arguments.front();
+                                Value val = token.substr(pos);
+                                int ordinal = arg.d_func()->expectedValues.empty()
+                                                  ? -1
+                                                  : arg.d_func()->indexOfExpectedValue(val);
+                                currentOption = opt;
+                                storeValue(arg, resVec, 0, std::move(val), ordinal);
+                                currentOption = nullptr;
+                            }
                         } else if (!dd->arguments.empty()) {
                             int minArgCount = (optData.optionalArgIndex < 0)
                                                   ? int(dd->arguments.size())
@@ -417,13 +510,8 @@ namespace SysCmdLine {
                             auto j = i + minArgCount + 1; // next of last required index
                             if (j > params.size()) {
                                 size_t argIndex = params.size() - i - 1;
-                                buildError(ParseResult::MissingOptionArgument,
-                                           {
-                                               dd->arguments[argIndex].helpText(
-                                                   Symbol::HP_ErrorText, displayOptions),
-                                               opt->helpText(Symbol::HP_ErrorText, displayOptions),
-                                           },
-                                           {}, nullptr, opt);
+                                buildError(ParseResult::MissingOptionArgument, {},
+                                           &dd->arguments[argIndex], opt);
                                 break;
                             }
 
@@ -438,25 +526,35 @@ namespace SysCmdLine {
                                     break;
                                 }
 
-                                const auto &curToken = params[j];
-
                                 // Break at next option
-                                if (tryOption(curToken)) {
+                                if (tryOption(j)) {
                                     resultType = TRT_Option; // memorize last result
                                     break;
                                 }
 
                                 // Break at next group flags
-                                if (tryGroupFlags(curToken)) {
+                                if (tryGroupFlags(j)) {
                                     resultType = TRT_GroupFlags; // memorize last result
                                     break;
                                 }
                             }
 
-                            rangeData.push(int(i), int(j - i - 1));
+                            auto resVec = addOccurrence(optData);
+                            if (auto len = j - i - 1; len > 0) {
+                                // missing index must be -1
+                                // because we have already check the integrity
+                                currentOption = opt;
+                                std::ignore =
+                                    parsePositionalArguments(dd->arguments, &params[i + 1], len,
+                                                             resVec, optData.multiValueArgIndex);
+                                currentOption = nullptr;
+                            }
                             i = j - 1;
+                            if (shouldStop()) {
+                                break;
+                            }
                         } else {
-                            rangeData.push(int(i), 0);
+                            std::ignore = addOccurrence(optData);
                         }
 
                         if (opt->priorLevel() >
@@ -469,19 +567,20 @@ namespace SysCmdLine {
                     }
 
                     // Consider group flags
-                    if (lastResultType == TRT_GroupFlags || tryGroupFlags(token)) {
+                    if (lastResultType == TRT_GroupFlags || tryGroupFlags(i)) {
                         const auto &flags = groupFlagsResult;
                         bool failed = false;
                         for (const auto &optIdx : std::as_const(flags)) {
-                            auto &rangeData = optionRanges[optIdx];
+                            auto &optData = core.allOptionsResult[optIdx];
 
                             // Check option common
-                            if (!checkOptionCommon(token, optIdx, rangeData.size())) {
+                            if (!checkOptionCommon(token, optIdx, optData.count) &&
+                                !collectAllErrors) {
                                 failed = true;
                                 break;
                             }
 
-                            rangeData.push(int(i), 0);
+                            std::ignore = addOccurrence(optData);
                         }
 
                         if (failed) {
@@ -491,68 +590,46 @@ namespace SysCmdLine {
                         continue;
                     }
 
-                    // Consider argument
+                    // Consider argument, convert it at once if it's matched forward
+                    if (positionalCount < forwardEnd) {
+                        const auto &arg = cmdArgs[positionalCount++];
+                        Value val;
+                        int ordinal;
+                        if (!checkArgument(&arg, token, &val, true, &ordinal)) {
+                            if (!collectAllErrors)
+                                break;
+                            continue;
+                        }
+                        storeValue(arg, {core.argResult.data(), core.argOrdinals.data(), nullptr},
+                                   positionalCount - 1, std::move(val), ordinal);
+                        continue;
+                    }
+                    positionalCount++;
                     positionalArguments.push_back(token);
                 }
 
-                if (!positionalArguments.empty()) {
+                if (positionalCount > 0) {
                     hasArgument = true;
                 }
             }
 
-            void parseArguments() {
-                // Parse all options
-                bool failed = false;
-                for (int i = 0; i < core.allOptionsSize; ++i) {
-                    auto &resultData = core.allOptionsResult[i];
-                    const auto &args = resultData.option->d_func()->arguments;
-                    const auto &rangeData = optionRanges[i];
-                    const auto &occurrence = int(rangeData.starts.size());
-
-                    resultData.count = occurrence;
-                    resultData.argResult = new std::vector<Value> *[occurrence];
-                    for (int j = 0; j < occurrence; ++j) {
-                        resultData.argResult[j] = new std::vector<Value>[resultData.argSize];
-                        for (int k = 0; k < resultData.argSize; ++k) {
-                            resultData.argResult[j][k].reserve(1); // most are single-value argument
-                        }
-                    }
-
-                    for (int j = 0; j < occurrence; ++j) {
-                        auto &resVec = resultData.argResult[j];
-
-                        const auto &start = rangeData.starts[j];
-                        const auto &len = rangeData.lengths[j];
-                        const auto &preceding = rangeData.precedingTokens[j];
-                        if (len == 0) {
-                            if (!preceding.empty()) {
-                                // single argument option
-                                resVec[0].emplace_back(preceding);
-                            }
-                            continue;
-                        }
-
-                        // missing index must be -1
-                        // because we have already check the integrity
-                        std::ignore =
-                            parsePositionalArguments(args, params.data() + start + 1, len, resVec,
-                                                     resultData.multiValueArgIndex);
-                        if (result->error != ParseResult::NoError) {
-                            failed = true;
-                            break;
-                        }
-                    }
-
-                    if (failed) {
-                        break;
+            void finishArguments() {
+                // Match the kept positional arguments
+                const auto &cmdArgs = targetCommandData->arguments;
+                size_t forwardEnd =
+                    core.multiValueArgIndex >= 0 ? size_t(core.multiValueArgIndex) : cmdArgs.size();
+                int missingIdx = -1;
+                if (positionalCount < forwardEnd) {
+                    if (cmdArgs[positionalCount].isRequired()) {
+                        missingIdx = int(positionalCount);
                     }
+                } else {
+                    missingIdx = parseTrailingArguments(
+                        cmdArgs, positionalArguments.data(), positionalArguments.size(),
+                        {core.argResult.data(), core.argOrdinals.data(), nullptr},
+                        core.multiValueArgIndex);
                 }
-
-                // Parse positional arguments
-                auto missingIdx = parsePositionalArguments(
-                    targetCommandData->arguments, positionalArguments.data(),
-                    positionalArguments.size(), core.argResult, core.multiValueArgIndex);
-                if (result->error != ParseResult::NoError) {
+                if (shouldStop()) {
                     return;
                 }
 
@@ -564,12 +641,7 @@ namespace SysCmdLine {
                         auto &optionData = core.allOptionsResult[i];
                         const auto &opt = *optionData.option;
                         if (opt.priorLevel() == Option::AutoSetWhenNoSymbols) {
-                            optionData.count = 1;
-
-                            // new
-                            auto &resultData = optionData.argResult;
-                            resultData = new std::vector<Value> *[1];
-                            resultData[0] = new std::vector<Value>[0]; // alloc empty
+                            std::ignore = addOccurrence(optionData);
 
                             hasAutoOption = true;
                             break;
@@ -581,40 +653,44 @@ namespace SysCmdLine {
                 bool canIgnoreSymbols =
                     priorOpt && priorOpt->priorLevel() >= Option::IgnoreMissingSymbols;
                 if (canIgnoreSymbols || hasAutoOption) {
-                    // ...
-                } else if (!canIgnoreArgumnents && missingIdx >= 0) {
-                    // Required arguments
+                    return;
+                }
+
+                // Required arguments
+                if (!canIgnoreArgumnents && missingIdx >= 0) {
                     const auto &arg = targetCommandData->arguments[missingIdx];
-                    buildError(ParseResult::MissingCommandArgument,
-                               {
-                                   arg.helpText(Symbol::HP_ErrorText, displayOptions),
-                               },
-                               {}, &arg);
-                } else {
-                    // Required options
-                    const Option *missingOpt = nullptr;
-                    for (int i = 0; i < core.allOptionsSize; ++i) {
-                        const auto &opt = *core.allOptionsResult[i].option;
-                        if (opt.isRequired() && searchExclusiveOption(i) < 0 &&
-                            core.allOptionsResult[i].count == 0) {
-                            missingOpt = &opt;
-                            break;
-                        }
+                    buildError(ParseResult::MissingCommandArgument, {}, &arg);
+                    if (!collectAllErrors) {
+                        return;
                     }
+                }
 
-                    if (missingOpt) {
-                        buildError(ParseResult::MissingRequiredOption,
-                                   {
-                                       missingOpt->helpText(Symbol::HP_ErrorText, displayOptions),
-                                   },
-                                   {}, nullptr, missingOpt);
+                // Required options, an exclusive group is satisfied by any of its members
+                for (size_t w = 0; w < requiredOptionMask.size(); ++w) {
+                    auto missing = requiredOptionMask[w] & ~seenOptionMask[w];
+                    for (int i = int(w * 64); missing; ++i, missing >>= 1) {
+                        if ((missing & 1) && searchExclusiveOption(i) < 0) {
+                            buildError(ParseResult::MissingRequiredOption, {}, nullptr,
+                                       core.allOptionsResult[i].option);
+                            if (!collectAllErrors) {
+                                return;
+                            }
+                        }
                     }
                 }
             }
 
-            std::vector<std::string> params;
+            std::vector<std::string> &params;
+            bool paramsExpanded = false; // differ from the input by a response file
             const int parseOptions;
+            const bool collectAllErrors;
             const int displayOptions;
+            const int parallelThreshold;
+            const ParserPrivate *const parserData;
+
+            // Tokens are checked in parallel by chunks, and only if there are a few chunks
+            static constexpr const size_t chunkSize = 1024;
+            static constexpr const size_t minParallelCount = 4 * chunkSize;
             const Command *const rootCommand;
 
             ParseResultPrivate *result;
@@ -624,51 +700,50 @@ namespace SysCmdLine {
             bool hasArgument = false;
             bool hasOption = false;
             const Option *priorOpt = nullptr;
-
-            GenericMap allOptionTokenIndexes;
-            GenericMap lowerOptionTokenIndexes;
-            GenericMap encounteredExclusiveGroups;
-
-            struct OptionRange {
-                std::vector<int> starts;
-                std::vector<int> lengths;
-                std::vector<std::string> precedingTokens;
-
-                void push(int s, int l, std::string preceding = {}) {
-                    starts.push_back(s);
-                    lengths.push_back(l);
-                    precedingTokens.emplace_back(std::move(preceding));
-                }
-
-                inline int size() const {
-                    return int(starts.size());
-                }
+            size_t positionalCount = 0;
+
+            // Values are reported to the visitor instead of being stored if set
+            Parser::Visitor *const visitor;
+            const Option *currentOption = nullptr; // owner of the arguments being converted
+
+            // Buffers in the scratch
+            std::vector<int> &encounteredExclusiveGroups;
+            std::vector<uint64_t> &requiredOptionMask;
+            std::vector<uint64_t> &seenOptionMask;
+            std::vector<std::string> &positionalArguments; // from the multi-value argument on
+
+            enum TokenKind {
+                TK_Dash = 0x1,  // starts with `-`
+                TK_Slash = 0x2, // starts with `/`
+                TK_Alnum = 0x4, // all alphanumeric after the first character
+                TK_Flags = TK_Dash | TK_Alnum,
             };
+            std::vector<unsigned char> &tokenKinds;
 
-            OptionRange *optionRanges = nullptr;
-            std::vector<std::string> positionalArguments;
+            int groupFlagIndexes[256]; // letter -> option index, -1 if none
+            uint64_t noArgFlagMask[4]; // letters whose option takes no argument
+            std::vector<int> &groupFlagsResult;
 
-            // Reusable functions
-            void buildOptionTokenIndexes(GenericMap &indexes,
-                                         std::string (*f)(const std::string &)) const {
-                for (int i = 0; i < core.allOptionsSize; ++i) {
-                    const auto &opt = core.allOptionsResult[i].option;
-                    for (const auto &token : opt->d_func()->tokens) {
-                        indexes[f(token)] = ele(i);
-                    }
-                }
-            }
+            std::vector<ParseScratch::PendingBinding> &pendingBindings;
+            std::vector<const ArgumentPrivate *> &boundArguments;
+            std::vector<int> &bulkInts;
+            std::vector<int64_t> &bulkInt64s;
+            std::vector<double> &bulkDoubles;
 
+            // Reusable functions
             static inline void initOptionData(OptionData &data, const Option *option) {
                 data.option = option;
+                data.count = 0;
                 initArgumentHolderData(data, option->d_func()->arguments);
+                data.totalCounts.assign(data.argSize, 0);
             }
 
             static void initArgumentHolderData(ArgumentHolderData &data,
                                                const std::vector<Argument> &args) {
+                data.optionalArgIndex = -1;
+                data.multiValueArgIndex = -1;
                 data.argSize = int(args.size());
 
-                // Build arg name indexes
                 for (int i = 0; i < args.size(); ++i) {
                     const auto &arg = args[i];
                     if (arg.isOptional() && data.optionalArgIndex < 0) {
@@ -677,10 +752,39 @@ namespace SysCmdLine {
                     if (arg.multiValueEnabled() && data.multiValueArgIndex < 0) {
                         data.multiValueArgIndex = i;
                     }
-                    data.argNameIndexes[arg.name()] = ele(i);
                 }
             };
 
+            // Clear the first `n` value lists, the rest keep their capacity for later parses
+            static void resetValueSlots(std::vector<std::vector<Value>> &slots, size_t n) {
+                if (slots.size() < n) {
+                    slots.resize(n);
+                }
+                for (size_t i = 0; i < n; ++i) {
+                    slots[i].clear();
+                }
+            }
+
+            // Count an occurrence of the option and clear its value lists
+            // -> value lists of the occurrence, null if parsing events
+            ValueSlots addOccurrence(OptionData &data) const {
+                if (visitor) {
+                    visitor->onOption(*data.option, data.count++);
+                    return {nullptr, nullptr, nullptr};
+                }
+                auto n = size_t(data.count + 1) * data.argSize;
+                if (data.argResult.size() < n) {
+                    data.argResult.resize(n);
+                    data.ordinals.resize(n);
+                }
+                auto res = data.occurrence(data.count++);
+                for (int i = 0; i < data.argSize; ++i) {
+                    res.values[i].clear();
+                    res.ordinals[i] = -1;
+                }
+                return res;
+            }
+
             // indexes: token indexes map
             // token:   token
             // pos:     followed argument beginning index
@@ -796,100 +900,135 @@ namespace SysCmdLine {
                 return -1;
             };
 
-            // token:   token
+            // token:   token starting with `-` or `/`
             // pos:     followed argument beginning index
             // ->       option index
             int searchOption(const std::string &token, int *pos = nullptr) const {
-                if (auto ch = token.front(); ch != '-' && ch != '/') {
-                    return -1;
-                }
-
                 // first search case-sensitive map
-                if (auto idx = searchOptionImpl(allOptionTokenIndexes, token, pos); idx >= 0)
+                const auto &optionTable = *core.optionTable;
+                if (auto idx = searchOptionImpl(optionTable.tokenIndexes, token, pos); idx >= 0)
                     return idx;
 
                 // second search case-insensitive map if flag is set
                 if ((parseOptions & Parser::IgnoreOptionCase)) {
-                    return searchOptionImpl(lowerOptionTokenIndexes, Utils::toLower(token), pos);
+                    return searchOptionImpl(optionTable.lowerTokenIndexes, Utils::toLower(token),
+                                            pos);
                 }
                 return -1;
             };
 
-            // flags: group flags without preceding '-'
-            // ->     option indexes
-            std::vector<int> searchGroupFlags(const std::string &flags) const {
-                std::vector<int> res;
-                char token[] = {'-', '-', '\0'};
+            void buildGroupFlagTable() {
+                std::fill(std::begin(groupFlagIndexes), std::end(groupFlagIndexes), -1);
+                std::fill(std::begin(noArgFlagMask), std::end(noArgFlagMask), 0);
+                for (int i = 0; i < core.allOptionsSize; ++i) {
+                    const auto &opt = core.allOptionsResult[i].option;
+                    const auto &optData = opt->d_func();
+                    for (const auto &token : optData->tokens) {
+                        if (token.size() != 2 || token.front() != '-')
+                            continue;
+                        // A later option owns the letter, including whether it's a flag
+                        auto ch = (unsigned char) token[1];
+                        auto bit = uint64_t(1) << (ch & 63);
+                        groupFlagIndexes[ch] = i;
+                        if (optData->arguments.empty()) {
+                            noArgFlagMask[ch >> 6] |= bit;
+                        } else {
+                            noArgFlagMask[ch >> 6] &= ~bit;
+                        }
+                    }
+                }
+            }
+
+            // flags: group flags with preceding '-'
+            // ->     whether all are flags, option indexes stored in `groupFlagsResult`
+            bool searchGroupFlags(const std::string &flags) {
+                groupFlagsResult.clear();
                 for (size_t i = 1; i < flags.size(); ++i) {
-                    token[1] = flags[i];
+                    auto ch = (unsigned char) flags[i];
 
                     // Must be all of flags
-                    auto it = allOptionTokenIndexes.find(token);
-                    if (it == allOptionTokenIndexes.end()) {
-                        return {};
-                    }
-                    const auto &idx = it->second.i;
-                    const auto &opt = core.allOptionsResult[idx].option;
-                    if (!opt->d_func()->arguments.empty()) {
-                        return {};
+                    if (!(noArgFlagMask[ch >> 6] & (uint64_t(1) << (ch & 63)))) {
+                        return false;
                     }
-                    res.push_back(idx);
+                    groupFlagsResult.push_back(groupFlagIndexes[ch]);
                 }
-                return res;
+                return !groupFlagsResult.empty();
             };
 
-            void buildError(ParseResult::Error error, const std::vector<std::string> &placeholders,
-                            const std::string &cancellationToken, const Argument *arg,
-                            const Option *opt = nullptr) const {
+            // The error text is formatted by the result on demand
+            void buildError(ParseResult::Error error, const std::string &cancellationToken,
+                            const Argument *arg, const Option *opt = nullptr,
+                            const Option *relatedOpt = nullptr, std::string detail = {}) const {
                 auto &res = *result;
-                res.error = error;
-                res.errorPlaceholders = placeholders;
-                res.cancellationToken = cancellationToken;
-                res.errorArgument = arg;
-                res.errorOption = opt;
+                if (!collectAllErrors) {
+                    res.errors.clear();
+                    res.error = error;
+                } else if (res.error == ParseResult::NoError) {
+                    res.error = error;
+                }
+                res.errors.push_back(
+                    {error, opt, arg, relatedOpt, std::move(detail), cancellationToken});
+                if (visitor) {
+                    visitor->onError(error, cancellationToken);
+                }
             };
 
+            inline bool shouldStop() const {
+                return result->error != ParseResult::NoError && !collectAllErrors;
+            }
+
             // arg:       input argument
             // token:     token
             // val:       return value if success
             // setError:  whether to build error message if failed
+            // ordinal:   return index of the value in the expected values if success
             bool checkArgument(const Argument *arg, const std::string &token, Value *out,
-                               bool setError = true) const {
+                               bool setError = true, int *ordinal = nullptr) const {
+                if (ordinal)
+                    *ordinal = -1;
+
                 const auto &d = arg->d_func();
                 const auto &expectedValues = d->expectedValues;
                 if (!expectedValues.empty()) {
-                    for (const auto &item : expectedValues) {
-                        auto val = Value::fromString(token, item.type());
-                        if (val == item) {
-                            *out = val;
-                            return true;
-                        }
+                    if (auto idx = d->matchExpectedValue(
+                            token, (parseOptions & Parser::IgnoreValueCase) != 0);
+                        idx >= 0) {
+                        *out = expectedValues[idx];
+                        if (ordinal)
+                            *ordinal = idx;
+                        return true;
                     }
                     if (setError) {
                         if (token.front() == '-') {
-                            buildError(ParseResult::InvalidOptionPosition, {token, arg->name()},
-                                       token, arg);
+                            buildError(ParseResult::InvalidOptionPosition, token, arg);
                         } else {
-                            buildError(ParseResult::InvalidArgumentValue, {token, arg->name()},
-                                       token, arg);
+                            buildError(ParseResult::InvalidArgumentValue, token, arg);
                         }
                     }
                     return false;
                 }
 
+                if (d->batchValidator) {
+                    return checkArgumentBatch(arg, &token, 1, out, setError) < 0;
+                }
+
                 if (d->validator) {
                     std::string errorMessage;
                     if (d->validator(token, out, &errorMessage)) {
                         return true;
                     }
                     if (setError) {
-                        buildError(ParseResult::ArgumentValidateFailed,
-                                   {token, arg->name(), errorMessage}, token, arg);
+                        buildError(ParseResult::ArgumentValidateFailed, token, arg, nullptr,
+                                   nullptr, std::move(errorMessage));
                     }
                     return false;
                 }
 
-                const auto &type = d->defaultValue.type();
+                // The type of bound storage is used if no default value
+                auto type = d->defaultValue.type();
+                if (type == Value::Null) {
+                    type = d->bindingType;
+                }
                 if (type == Value::Null) {
                     *out = token; // no default value
                     return true;
@@ -899,17 +1038,104 @@ namespace SysCmdLine {
                     return true;
                 }
                 if (setError) {
-                    buildError(ParseResult::ArgumentTypeMismatch,
-                               {
-                                   token,
-                                   arg->name(),
-                                   Value::typeName(type),
-                               },
-                               token, arg);
+                    buildError(ParseResult::ArgumentTypeMismatch, token, arg, nullptr, nullptr,
+                               Value::typeName(type));
                 }
                 return false;
             };
 
+            // arg:       input argument with batch validator
+            // tokens:    tokens
+            // count:     tokens count
+            // out:       return values, must be as many as tokens
+            // setError:  whether to build error message if failed
+            // ->         first failed index, -1 if all succeeded
+            int checkArgumentBatch(const Argument *arg, const std::string *tokens, size_t count,
+                                   Value *out, bool setError = true) const {
+                std::string errorMessage;
+                auto failedIdx =
+                    arg->d_func()->batchValidator(tokens, int(count), out, &errorMessage);
+                if (failedIdx >= 0) {
+                    if (setError) {
+                        const auto &token = tokens[failedIdx];
+                        buildError(ParseResult::ArgumentValidateFailed, token, arg, nullptr,
+                                   nullptr, std::move(errorMessage));
+                    }
+                    return failedIdx;
+                }
+
+                // Use the token if the validator doesn't give a value
+                for (size_t i = 0; i < count; ++i) {
+                    if (out[i].type() == Value::Null) {
+                        out[i] = tokens[i];
+                    }
+                }
+                return -1;
+            }
+
+            // arg:       input argument
+            // tokens:    tokens
+            // count:     tokens count
+            // out:       return values, must be as many as tokens
+            // ->         first failed index, -1 if all succeeded
+            int checkArgumentParallel(const Argument *arg, const std::string *tokens, size_t count,
+                                      Value *out) const {
+                size_t chunkCount = (count + chunkSize - 1) / chunkSize;
+                size_t threadCount =
+                    std::min<size_t>(std::max(std::thread::hardware_concurrency(), 1u), chunkCount);
+
+                // Threads take chunks in order, the chunks behind a failed one are skipped
+                std::atomic<size_t> nextChunk(0);
+                std::atomic<size_t> failedIdx(count);
+
+                // A throwing validator stops all threads, the exception is rethrown after join
+                std::vector<std::exception_ptr> exceptions(threadCount);
+
+                const auto &work = [&](size_t threadIdx) {
+                    try {
+                        size_t chunk;
+                        while ((chunk = nextChunk.fetch_add(1)) < chunkCount) {
+                            size_t begin = chunk * chunkSize;
+                            if (begin >= failedIdx.load())
+                                break;
+
+                            size_t end = std::min(begin + chunkSize, count);
+                            for (size_t i = begin; i < end; ++i) {
+                                if (checkArgument(arg, tokens[i], &out[i], false))
+                                    continue;
+
+                                // Keep the smallest one
+                                size_t cur = failedIdx.load();
+                                while (i < cur && !failedIdx.compare_exchange_weak(cur, i)) {
+                                }
+                                break;
+                            }
+                        }
+                    } catch (...) {
+                        exceptions[threadIdx] = std::current_exception();
+                        nextChunk.store(chunkCount);
+                    }
+                };
+
+                std::vector<std::thread> threads;
+                threads.reserve(threadCount - 1);
+                for (size_t i = 1; i < threadCount; ++i) {
+                    threads.emplace_back(work, i);
+                }
+                work(0);
+                for (auto &thread : threads) {
+                    thread.join();
+                }
+
+                for (const auto &exception : std::as_const(exceptions)) {
+                    if (exception)
+                        std::rethrow_exception(exception);
+                }
+
+                auto res = failedIdx.load();
+                return res < count ? int(res) : -1;
+            }
+
             // optIndex:         option index of all option list
             // insertIfNotFound: if not colliding, set current group as visited
             // ->                colliding option index in command's option list
@@ -918,17 +1144,17 @@ namespace SysCmdLine {
                     return -1;
                 optIndex -= core.globalOptionsSize; // get index in command's option list
 
-                const auto &groupName = targetCommandData->optionGroupNames[optIndex];
-                if (groupName.empty())
+                const auto &groupId = targetCommandData->optionGroupIds[optIndex];
+                if (groupId < 0)
                     return -1;
 
-                auto it2 = encounteredExclusiveGroups.find(groupName);
-                if (it2 != encounteredExclusiveGroups.end()) {
-                    return it2->second.i; // colliding
+                auto &first = encounteredExclusiveGroups[groupId];
+                if (first >= 0) {
+                    return first; // colliding
                 }
 
                 if (insertIfNotFound) {
-                    encounteredExclusiveGroups[groupName] = ele(optIndex);
+                    first = optIndex;
                 }
                 return -1;
             };
@@ -937,12 +1163,7 @@ namespace SysCmdLine {
                 const auto &opt = core.allOptionsResult[optIndex].option;
                 // Check max occurrence
                 if (opt->maxOccurrence() > 0 && occurrence == opt->maxOccurrence()) {
-                    buildError(ParseResult::OptionOccurTooMuch,
-                               {
-                                   opt->helpText(Symbol::HP_ErrorText, displayOptions),
-                                   std::to_string(opt->maxOccurrence()),
-                               },
-                               token, nullptr, opt);
+                    buildError(ParseResult::OptionOccurTooMuch, token, nullptr, opt);
                     return false;
                 }
 
@@ -951,41 +1172,25 @@ namespace SysCmdLine {
                     switch (priorOpt->priorLevel()) {
                         case Option::ExclusiveToArguments: {
                             if (hasArgument) {
-                                buildError(
-                                    ParseResult::PriorOptionWithArguments,
-                                    {
-                                        priorOpt->helpText(Symbol::HP_ErrorText, displayOptions),
-                                    },
-                                    token, nullptr, opt);
+                                buildError(ParseResult::PriorOptionWithArguments, token, nullptr,
+                                           opt, priorOpt);
                             }
                             break;
                         }
                         case Option::ExclusiveToOptions: {
                             if (hasOption) {
-                                buildError(
-                                    ParseResult::PriorOptionWithOptions,
-                                    {
-                                        priorOpt->helpText(Symbol::HP_ErrorText, displayOptions),
-                                    },
-                                    token, nullptr, opt);
+                                buildError(ParseResult::PriorOptionWithOptions, token, nullptr,
+                                           opt, priorOpt);
                             }
                             break;
                         }
                         case Option::ExclusiveToAll: {
                             if (hasArgument) {
-                                buildError(
-                                    ParseResult::PriorOptionWithArguments,
-                                    {
-                                        priorOpt->helpText(Symbol::HP_ErrorText, displayOptions),
-                                    },
-                                    token, nullptr, opt);
+                                buildError(ParseResult::PriorOptionWithArguments, token, nullptr,
+                                           opt, priorOpt);
                             } else if (hasOption) {
-                                buildError(
-                                    ParseResult::PriorOptionWithOptions,
-                                    {
-                                        priorOpt->helpText(Symbol::HP_ErrorText, displayOptions),
-                                    },
-                                    token, nullptr, opt);
+                                buildError(ParseResult::PriorOptionWithOptions, token, nullptr,
+                                           opt, priorOpt);
                             }
                             break;
                         }
@@ -998,23 +1203,213 @@ namespace SysCmdLine {
                 {
                     const auto &exclusiveIdx = searchExclusiveOption(optIndex, true);
                     if (exclusiveIdx >= 0) {
-                        buildError(ParseResult::MutuallyExclusiveOptions,
-                                   {
-                                       core.allOptionsResult[core.globalOptionsSize + exclusiveIdx]
-                                           .option->helpText(Symbol::HP_ErrorText, displayOptions),
-                                       opt->helpText(Symbol::HP_ErrorText, displayOptions),
-                                   },
-                                   token, nullptr, opt);
+                        buildError(
+                            ParseResult::MutuallyExclusiveOptions, token, nullptr, opt,
+                            core.allOptionsResult[core.globalOptionsSize + exclusiveIdx].option);
                         return false;
                     }
                 }
+
+                seenOptionMask[optIndex >> 6] |= uint64_t(1) << (optIndex & 63);
                 return true;
             };
 
-            static bool isFlags(const std::string &s) {
-                if (s.size() <= 1 || s.front() != '-')
-                    return false;
-                return std::all_of(s.begin() + 1, s.end(), ::isalnum);
+            // Bound values are kept for the user storage instead of the result
+            // res:     result slots, unused if parsing events
+            // index:   argument index
+            // ordinal: index of the value in the expected values, -1 if none
+            inline void storeValue(const Argument &arg, const ValueSlots &res, size_t index,
+                                   Value val, int ordinal = -1) const {
+                if (visitor) {
+                    visitor->onArgument(arg, val, currentOption);
+                    return;
+                }
+                const auto &d = arg.d_func();
+                if (d->bindingTarget) {
+                    if (boundArguments.empty() || boundArguments.back() != d) {
+                        boundArguments.push_back(d);
+                    }
+                    pendingBindings.push_back({d, std::move(val), 0, 0});
+                    return;
+                }
+                auto &values = res.values[index];
+                if (values.empty()) {
+                    res.ordinals[index] = ordinal;
+                }
+                values.push_back(std::move(val));
+                if (res.totalCounts) {
+                    res.totalCounts[index]++;
+                }
+            }
+
+            // Write the bound storage after the parse succeeded, the default values go to
+            // the arguments that got nothing, like what the result gives
+            void commitBindings() const {
+                const auto &append = [](auto &vec, const auto &buffer, size_t first,
+                                        size_t count) {
+                    vec.insert(vec.end(), buffer.begin() + first, buffer.begin() + first + count);
+                };
+
+                // List targets hold the values of this parse only
+                for (const auto &d : std::as_const(boundArguments)) {
+                    d->clearBinding();
+                }
+                for (const auto &item : std::as_const(pendingBindings)) {
+                    const auto &d = item.arg;
+                    if (item.bulkCount == 0) {
+                        d->assignBinding(item.value);
+                        continue;
+                    }
+                    switch (d->bindingType) {
+                        case Value::Int:
+                            append(d->bindingAs<std::vector<int>>(), bulkInts, item.bulkFirst,
+                                   item.bulkCount);
+                            break;
+                        case Value::Int64:
+                            append(d->bindingAs<std::vector<int64_t>>(), bulkInt64s,
+                                   item.bulkFirst, item.bulkCount);
+                            break;
+                        case Value::Double:
+                            append(d->bindingAs<std::vector<double>>(), bulkDoubles,
+                                   item.bulkFirst, item.bulkCount);
+                            break;
+                        default:
+                            break;
+                    }
+                }
+
+                for (const auto &arg : targetCommandData->arguments) {
+                    const auto &d = arg.d_func();
+                    if (d->bindingTarget && d->defaultValue.type() != Value::Null &&
+                        std::find(boundArguments.begin(), boundArguments.end(), d) ==
+                            boundArguments.end()) {
+                        d->clearBinding();
+                        d->assignBinding(d->defaultValue);
+                    }
+                }
+
+                for (int i = 0; i < core.allOptionsSize; ++i) {
+                    const auto &optData = core.allOptionsResult[i];
+                    const auto &optd = optData.option->d_func();
+                    if (optData.count > 0) {
+                        if (optd->flagTarget) {
+                            *optd->flagTarget = true;
+                        }
+                        continue;
+                    }
+                    for (const auto &arg : optd->arguments) {
+                        const auto &d = arg.d_func();
+                        if (d->bindingTarget && d->defaultValue.type() != Value::Null) {
+                            d->clearBinding();
+                            d->assignBinding(d->defaultValue);
+                        }
+                    }
+                }
+            }
+
+            // Numbers of a bound list are converted into the scratch without making values,
+            // and queued for the storage if all of them succeed
+            // d:      argument data
+            // tokens: tokens
+            // count:  tokens count
+            // ->      first failed index, -1 if all succeeded, -2 if not applicable
+            int bulkConvertNumbers(const ArgumentPrivate *d, const std::string *tokens,
+                                   size_t count) const {
+                if (!d->bindingIsList || !d->expectedValues.empty() || d->validator ||
+                    d->batchValidator)
+                    return -2;
+
+                const auto &type = d->bindingType;
+                if (d->defaultValue.type() != Value::Null && d->defaultValue.type() != type)
+                    return -2;
+
+                const auto &convert = [this, d, tokens, count](auto &buffer, auto parse) -> int {
+                    auto first = buffer.size();
+                    buffer.reserve(first + count);
+                    for (size_t i = 0; i < count; ++i) {
+                        const auto &token = tokens[i];
+                        typename std::decay_t<decltype(buffer)>::value_type val;
+                        if (!parse(token, &val)) {
+                            buffer.resize(first);
+                            return int(i);
+                        }
+                        buffer.push_back(val);
+                    }
+                    pendingBindings.push_back({d, {}, first, count});
+                    return -1;
+                };
+
+                size_t errorPos;
+                switch (type) {
+                    case Value::Int: {
+                        return convert(bulkInts, [&errorPos](const std::string &token, int *out) {
+                            int64_t l;
+                            if (parseInteger(token.data(), token.size(),
+                                             std::numeric_limits<int>::min(),
+                                             std::numeric_limits<int>::max(), &l,
+                                             &errorPos) != Value::NoConversionError)
+                                return false;
+                            *out = int(l);
+                            return true;
+                        });
+                    }
+                    case Value::Int64: {
+                        return convert(bulkInt64s,
+                                       [&errorPos](const std::string &token, int64_t *out) {
+                                           return parseInteger(
+                                                      token.data(), token.size(),
+                                                      std::numeric_limits<int64_t>::min(),
+                                                      std::numeric_limits<int64_t>::max(), out,
+                                                      &errorPos) == Value::NoConversionError;
+                                       });
+                    }
+                    case Value::Double: {
+                        return convert(bulkDoubles,
+                                       [&errorPos](const std::string &token, double *out) {
+                                           return parseDouble(token.data(), token.size(), out,
+                                                              &errorPos) ==
+                                                  Value::NoConversionError;
+                                       });
+                    }
+                    default:
+                        break;
+                }
+                return -2;
+            }
+
+            static inline bool isAsciiAlnum(char ch) {
+                return unsigned((ch | 0x20) - 'a') < 26 || unsigned(ch - '0') < 10;
+            }
+
+            // Classify all tokens in one pass, the later phases only read the kinds
+            void classifyTokens() {
+                tokenKinds.assign(params.size(), 0);
+                for (size_t i = nonCommandIndex; i < params.size(); ++i) {
+                    const auto &token = params[i];
+                    if (token.empty())
+                        continue;
+
+                    auto &kind = tokenKinds[i];
+                    switch (token.front()) {
+                        case '-':
+                            kind = TK_Dash;
+                            break;
+                        case '/':
+                            kind = TK_Slash;
+                            break;
+                        default:
+                            break;
+                    }
+
+                    if (token.size() > 1) {
+                        bool alnum = true;
+                        for (size_t j = 1; j < token.size(); ++j) {
+                            alnum &= isAsciiAlnum(token[j]);
+                        }
+                        if (alnum)
+                            kind |= TK_Alnum;
+                    }
+                }
             }
 
             static bool isSymbol(std::string_view s) {
@@ -1032,36 +1427,51 @@ namespace SysCmdLine {
             // if failed, the error will be set, check it first.
             int parsePositionalArguments(const std::vector<Argument> &args,
                                          const std::string *tokens, size_t tokensCount,
-                                         std::vector<Value> *res, int multiValueIndex) const {
-                // Parse forward
+                                         const ValueSlots &res, int multiValueIndex) const {
+                // Parse forward, the multi-value argument is checked as a whole later
                 size_t end = args.size();
                 if (multiValueIndex >= 0) {
-                    end = multiValueIndex + 1; // Stop after multi-value arg
+                    end = multiValueIndex;
                 }
 
                 size_t k = 0;
                 for (size_t max = std::min(tokensCount, end); k < max; ++k) {
                     const auto &arg = args.at(k);
                     Value val;
-                    if (!checkArgument(&arg, tokens[k], &val)) {
-                        return -1;
+                    int ordinal;
+                    if (!checkArgument(&arg, tokens[k], &val, true, &ordinal)) {
+                        if (!collectAllErrors)
+                            return -1;
+                        continue;
                     }
-                    res[k].push_back(val);
+                    storeValue(arg, res, k, std::move(val), ordinal);
                 }
 
                 if (k < end) {
-                    const auto &arg = args.at(k);
-                    if (arg.isRequired()) {
-                        return int(k);
-                    }
-                    return -1;
+                    return args.at(k).isRequired() ? int(k) : -1;
+                }
+                return parseTrailingArguments(args, tokens + k, tokensCount - k, res,
+                                              multiValueIndex);
+            }
+
+            // args:    arguments
+            // tokens:  tokens behind the forward matched arguments
+            // res:     result array
+            // ->       missing index
+            // if failed, the error will be set, check it first.
+            int parseTrailingArguments(const std::vector<Argument> &args,
+                                       const std::string *tokens, size_t tokensCount,
+                                       const ValueSlots &res, int multiValueIndex) const {
+                // The multi-value argument takes at least one token
+                if (multiValueIndex >= 0 && tokensCount == 0) {
+                    return args.at(multiValueIndex).isRequired() ? multiValueIndex : -1;
                 }
 
                 // Parse backward
-                end = tokensCount;
+                size_t end = tokensCount;
                 if (multiValueIndex >= 0 && multiValueIndex < args.size() - 1) {
                     size_t backwardCount = args.size() - multiValueIndex - 1;
-                    if (tokensCount < backwardCount + k) {
+                    if (tokensCount < backwardCount + 1) {
                         return multiValueIndex + 1;
                     }
                     end -= backwardCount;
@@ -1069,44 +1479,100 @@ namespace SysCmdLine {
                     for (size_t j = 0; j < backwardCount; ++j) {
                         const auto &arg = args.at(multiValueIndex + j + 1);
                         Value val;
-                        if (!checkArgument(&arg, tokens[end + j], &val)) {
-                            return -1;
+                        int ordinal;
+                        if (!checkArgument(&arg, tokens[end + j], &val, true, &ordinal)) {
+                            if (!collectAllErrors)
+                                return -1;
+                            continue;
                         }
-                        res[multiValueIndex + j + 1].push_back(val);
+                        storeValue(arg, res, multiValueIndex + j + 1, std::move(val), ordinal);
                     }
                 }
 
-                if (end <= k) {
+                // Too many
+                if (multiValueIndex < 0) {
+                    bool tooMany = false;
+                    for (size_t k = 0; k < end; ++k) {
+                        const auto &token = tokens[k];
+                        if (token.front() == '-') {
+                            buildError(ParseResult::UnknownOption, token, nullptr);
+                        } else if (args.empty() && isSymbol(token)) {
+                            buildError(ParseResult::UnknownCommand, token, nullptr);
+                        } else if (!tooMany) {
+                            buildError(ParseResult::TooManyArguments, token, nullptr);
+                            tooMany = true;
+                        }
+
+                        // Report every unexpected token if required
+                        if (!collectAllErrors)
+                            break;
+                    }
                     return -1;
                 }
 
-                // Too many
-                if (multiValueIndex < 0) {
-                    const auto &token = tokens[k];
-                    if (token.front() == '-') {
-                        buildError(ParseResult::UnknownOption, {token}, token, nullptr);
-                        return -1;
+                // Consider multiple arguments, at least one token left
+                const auto &arg = args.at(multiValueIndex);
+
+                // Validate all at once if possible
+                if (arg.d_func()->expectedValues.empty() && arg.d_func()->batchValidator) {
+                    std::vector<Value> values(end);
+                    auto failedIdx = checkArgumentBatch(&arg, tokens, end, values.data());
+                    if (failedIdx < 0) {
+                        for (auto &val : values) {
+                            storeValue(arg, res, multiValueIndex, std::move(val));
+                        }
                     }
+                    return -1;
+                }
 
-                    if (args.empty() && isSymbol(token)) {
-                        buildError(ParseResult::UnknownCommand, {token}, token, nullptr);
+                // Convert numbers of a bound array at once if possible, every token is checked
+                // on its own if all errors are collected
+                if (auto failedIdx = (visitor || collectAllErrors)
+                                         ? -2
+                                         : bulkConvertNumbers(arg.d_func(), tokens, end);
+                    failedIdx != -2) {
+                    if (failedIdx >= 0) {
+                        Value val;
+                        std::ignore = checkArgument(&arg, tokens[failedIdx], &val);
+                    } else {
+                        boundArguments.push_back(arg.d_func());
+                    }
+                    return -1;
+                }
+
+                // Check in multiple threads if there are too many, starting threads costs more
+                // than checking a few chunks in place
+                if (parallelThreshold > 0 &&
+                    end >= std::max(size_t(parallelThreshold), minParallelCount)) {
+                    std::vector<Value> values(end);
+                    auto failedIdx = checkArgumentParallel(&arg, tokens, end, values.data());
+                    if (failedIdx >= 0) {
+                        // Check again to build error
+                        Value val;
+                        std::ignore = checkArgument(&arg, tokens[failedIdx], &val);
                         return -1;
                     }
 
-                    buildError(ParseResult::TooManyArguments, {}, token, nullptr);
+                    // Only the first value has its ordinal kept
+                    const auto &d = arg.d_func();
+                    int ordinal =
+                        d->expectedValues.empty() ? -1 : d->indexOfExpectedValue(values.front());
+                    for (auto &val : values) {
+                        storeValue(arg, res, multiValueIndex, std::move(val), ordinal);
+                    }
                     return -1;
                 }
 
-                // Consider multiple arguments
-                const auto &arg = args.at(multiValueIndex);
-                auto &resVec = res[multiValueIndex];
-                for (size_t j = k; j < end; ++j) {
+                for (size_t j = 0; j < end; ++j) {
                     const auto &token = tokens[j];
                     Value val;
-                    if (!checkArgument(&arg, token, &val)) {
-                        break;
+                    int ordinal;
+                    if (!checkArgument(&arg, token, &val, true, &ordinal)) {
+                        if (!collectAllErrors)
+                            break;
+                        continue;
                     }
-                    resVec.push_back(val);
+                    storeValue(arg, res, multiValueIndex, std::move(val), ordinal);
                 }
                 return -1;
             };
@@ -1114,17 +1580,52 @@ namespace SysCmdLine {
 
     }
 
-    ParseResult Parser::parse(const std::vector<std::string> &args, int parseOptions) {
-        Q_D2(Parser);
-        ParserCore parserCore(args, parseOptions, d->displayOptions, &d->rootCommand);
+    static void parseInto(const Parser &parser, const std::vector<std::string> &args,
+                          int parseOptions, ParseScratch &scratch, ParseResultPrivate *result) {
+        ParserCore parserCore(args, parseOptions, parser.d_func(), scratch, result);
         std::ignore = parserCore.parse();
 
-        auto res = parserCore.result;
-        res->arguments = args;
-        res->parser = *this;
+        // Take over the copied tokens if they are still the input, the buffer of the old
+        // arguments is left to the scratch for the next parse
+        if (parserCore.paramsExpanded) {
+            result->arguments = args;
+        } else {
+            result->arguments.swap(scratch.params);
+        }
+        result->parser = parser;
+    }
+
+    ParseResult Parser::parse(const std::vector<std::string> &args, int parseOptions) {
+        ParseScratch scratch;
+        auto d = new ParseResultPrivate();
+        ParseResult res(d); // owned before a validator may throw
+        parseInto(*this, args, parseOptions, scratch, d);
         return res;
     }
 
+    void Parser::Visitor::onCommand(const Command & /*command*/) {
+    }
+
+    void Parser::Visitor::onOption(const Option & /*option*/, int /*occurrence*/) {
+    }
+
+    void Parser::Visitor::onArgument(const Argument & /*argument*/, const Value & /*value*/,
+                                     const Option * /*option*/) {
+    }
+
+    void Parser::Visitor::onError(ParseResult::Error /*error*/, const std::string & /*token*/) {
+    }
+
+    ParseResult::Error Parser::parseEvents(const std::vector<std::string> &args,
+                                           Visitor &visitor, int parseOptions) {
+        Q_D2(Parser);
+        ParseScratch scratch;
+        ParseResultPrivate res;
+        ParserCore parserCore(args, parseOptions, d, scratch, &res, &visitor);
+        std::ignore = parserCore.parse();
+        return res.error;
+    }
+
     int Parser::size(Parser::SizeType sizeType) const {
         Q_D2(Parser);
         return d->sizeConfig[sizeType];
@@ -1149,4 +1650,30 @@ namespace SysCmdLine {
         return Strings::en_US::provider;
     }
 
-}
\ No newline at end of file
+    ParseSession::ParseSession(const Parser &parser) : d_ptr(new ParseSessionPrivate()) {
+        d_ptr->parser = parser;
+    }
+
+    ParseSession::~ParseSession() {
+        delete d_ptr;
+    }
+
+    Parser ParseSession::parser() const {
+        return d_ptr->parser;
+    }
+
+    ParseResult ParseSession::parse(const std::vector<std::string> &args, int parseOptions) {
+        auto &result = d_ptr->result;
+        if (result.isDetached()) {
+            auto d = const_cast<ParseResultPrivate *>(result.d_func());
+            d->reset();
+            parseInto(d_ptr->parser, args, parseOptions, d_ptr->scratch, d);
+        } else {
+            auto d = new ParseResultPrivate();
+            result = ParseResult(d);
+            parseInto(d_ptr->parser, args, parseOptions, d_ptr->scratch, d);
+        }
+        return result;
+    }
+
+}
@@ -1,19 +1,71 @@
 #ifndef PARSER_P_H
 #define PARSER_P_H
 
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+
 #include "sharedbase_p.h"
 #include "parser.h"
 
+#include "map_p.h"
+
 namespace SysCmdLine {
 
+    class ArgumentPrivate;
+
+    // Options visible at a command node, inherited global options first and deduplicated
+    struct OptionTable {
+        std::vector<const Option *> options;
+        int globalOptionsSize = 0;
+        GenericMap tokenIndexes;            // token -> index of `options`
+        GenericMap lowerTokenIndexes;       // lower-case token -> index of `options`
+        std::vector<int> rootOptionIndexes; // option index of the root -> index of `options`
+    };
+
+    // Working buffers of a parse, kept by a session to reuse their capacity
+    struct ParseScratch {
+        std::vector<std::string> params;
+        std::vector<std::string> positionalArguments; // kept for backward matching
+        std::vector<unsigned char> tokenKinds;       // param index -> kind
+        std::vector<int> groupFlagsResult;
+        std::vector<int> encounteredExclusiveGroups; // group id -> first option index
+        std::vector<uint64_t> requiredOptionMask;    // bit per option of `allOptionsResult`
+        std::vector<uint64_t> seenOptionMask;
+
+        // Values of bound arguments in token order, written to the storage only if the
+        // parse succeeds
+        struct PendingBinding {
+            const ArgumentPrivate *arg;
+            Value value;
+            size_t bulkFirst; // range of the numbers converted in bulk, in the buffer of the type
+            size_t bulkCount; // 0 if the value is used
+        };
+        std::vector<PendingBinding> pendingBindings;
+        std::vector<const ArgumentPrivate *> boundArguments; // ones that received a value
+        std::vector<int> bulkInts;
+        std::vector<int64_t> bulkInt64s;
+        std::vector<double> bulkDoubles;
+    };
+
+    class ParseSessionPrivate {
+    public:
+        Parser parser;
+        ParseScratch scratch;
+        ParseResult result; // reused if no longer referenced elsewhere
+    };
+
     class ParserPrivate : public SharedBasePrivate {
     public:
         ParserPrivate();
+        ParserPrivate(const ParserPrivate &other);
         ParserPrivate *clone() const;
 
         Command rootCommand;
         std::string prologue, epilogue;
         int displayOptions;
+        int parallelThreshold;
 
         int sizeConfig[3] = {
             4,
@@ -23,6 +75,12 @@ namespace SysCmdLine {
 
         Parser::TextProvider textProvider;
 
+        // Built on first use of each command path, dropped when the root command changes
+        mutable std::mutex optionTablesMutex;
+        mutable std::map<std::vector<int>, std::shared_ptr<const OptionTable>> optionTables;
+
+        std::shared_ptr<const OptionTable> optionTable(const std::vector<int> &stack) const;
+
         inline std::string indent() const {
             return std::string(sizeConfig[Parser::ST_Indent], ' ');
         }
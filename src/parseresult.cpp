@@ -10,6 +10,7 @@
 
 #include "parser_p.h"
 #include "option_p.h"
+#include "argument_p.h"
 #include "helplayout_p.h"
 #include "command_p.h"
 
@@ -25,6 +26,16 @@ namespace SysCmdLine {
         return _data;
     }
 
+    std::vector<Value> ValueRange::toVector() const {
+        std::vector<Value> res;
+        res.reserve(total);
+        for (int i = 0; i < count; ++i) {
+            const auto &values = slots[size_t(i) * stride + index];
+            res.insert(res.end(), values.begin(), values.end());
+        }
+        return res;
+    }
+
     OptionResult::OptionResult() : data(&OptionData::sharedNull()) {
     }
 
@@ -35,8 +46,11 @@ namespace SysCmdLine {
 
     int OptionResult::indexOf(const std::string &name) const {
         auto &v = *reinterpret_cast<const OptionData *>(data);
-        auto it = v.argNameIndexes.find(name);
-        if (it == v.argNameIndexes.end())
+        if (!v.option)
+            return -1;
+        const auto &indexes = v.option->d_func()->argumentNameIndexes;
+        auto it = indexes.find(name);
+        if (it == indexes.end())
             return -1;
         return it->second.i;
     }
@@ -51,13 +65,21 @@ namespace SysCmdLine {
         if (index < 0 || index >= v.argSize)
             return {};
 
-        std::vector<Value> allValues;
-        for (int i = 0; i < v.count; ++i) {
-            const auto &values = v.argResult[i][index];
-            // allValues.insert(allValues.end(), values.begin(), values.end());
-            allValues = Utils::concatVector(allValues, values);
-        }
-        return allValues;
+        return allValuesView(index).toVector();
+    }
+
+    ValueRange OptionResult::allValuesView(int index) const {
+        auto &v = *reinterpret_cast<const OptionData *>(data);
+        if (index < 0 || index >= v.argSize)
+            return {};
+        return {v.argResult.data(), v.argSize, index, v.count, totalCount(index)};
+    }
+
+    int OptionResult::totalCount(int index) const {
+        auto &v = *reinterpret_cast<const OptionData *>(data);
+        if (index < 0 || index >= int(v.totalCounts.size()))
+            return 0;
+        return v.totalCounts[index];
     }
 
     const std::vector<Value> &OptionResult::values(int index, int n) const {
@@ -66,7 +88,7 @@ namespace SysCmdLine {
             return sharedEmptyValues();
         if (n < 0 || n >= v.count)
             return sharedEmptyValues();
-        return v.argResult[n][index];
+        return v.values(n, index);
     }
 
     Value OptionResult::value(int index, int n) const {
@@ -75,13 +97,84 @@ namespace SysCmdLine {
             return {};
         if (n < 0 || n >= v.count)
             return v.option->d_func()->arguments[index].defaultValue();
-        const auto &args = v.argResult[n][index];
+        const auto &args = v.values(n, index);
         return args.empty() ? Value() : args.front();
     }
 
+    int OptionResult::ordinal(int index, int n) const {
+        auto &v = *reinterpret_cast<const OptionData *>(data);
+        if (index < 0 || index >= v.argSize)
+            return -1;
+        if (n < 0 || n >= v.count)
+            return v.option->d_func()->arguments[index].d_func()->defaultOrdinal;
+        return v.ordinals[size_t(n) * v.argSize + index];
+    }
+
+    std::vector<std::string> ErrorRecord::placeholders(int displayOptions) const {
+        switch (error) {
+            case ParseResult::UnknownOption:
+            case ParseResult::UnknownCommand:
+                return {token};
+            case ParseResult::MissingOptionArgument:
+                return {
+                    argument->helpText(Symbol::HP_ErrorText, displayOptions),
+                    option->helpText(Symbol::HP_ErrorText, displayOptions),
+                };
+            case ParseResult::MissingCommandArgument:
+                return {argument->helpText(Symbol::HP_ErrorText, displayOptions)};
+            case ParseResult::InvalidArgumentValue:
+            case ParseResult::InvalidOptionPosition:
+                return {token, argument->name()};
+            case ParseResult::MissingRequiredOption:
+                return {option->helpText(Symbol::HP_ErrorText, displayOptions)};
+            case ParseResult::OptionOccurTooMuch:
+                return {
+                    option->helpText(Symbol::HP_ErrorText, displayOptions),
+                    std::to_string(option->maxOccurrence()),
+                };
+            case ParseResult::ArgumentTypeMismatch:
+            case ParseResult::ArgumentValidateFailed:
+                return {token, argument->name(), detail};
+            case ParseResult::MutuallyExclusiveOptions:
+                return {
+                    relatedOption->helpText(Symbol::HP_ErrorText, displayOptions),
+                    option->helpText(Symbol::HP_ErrorText, displayOptions),
+                };
+            case ParseResult::PriorOptionWithArguments:
+            case ParseResult::PriorOptionWithOptions:
+                return {relatedOption->helpText(Symbol::HP_ErrorText, displayOptions)};
+            case ParseResult::ErrorReadingResponseFile:
+                return {token.substr(1)};
+            default:
+                break;
+        }
+        return {};
+    }
+
+    void ParseResultPrivate::reset() {
+        error = ParseResult::NoError;
+        errors.clear();
+        stack.clear();
+        command = nullptr;
+        core.allOptionsSize = 0;
+        core.globalOptionsSize = 0;
+        std::fill(std::begin(roleSet), std::end(roleSet), false);
+    }
+
+    std::string ParseResultPrivate::errorText(int index) const {
+        const auto &parserData = parser.d_func();
+        const auto &record = errors[index];
+        return Utils::formatText(parserData->textProvider(Strings::ParseError, record.error),
+                                 record.placeholders(parserData->displayOptions));
+    }
+
     std::string ParseResultPrivate::correctionText() const {
+        if (errors.empty())
+            return {};
+
+        const auto &record = errors.front();
         std::vector<std::string> expectedValues;
-        switch (error) {
+        switch (record.error) {
             case ParseResult::UnknownOption: {
                 for (int i = 0; i < core.allOptionsSize; ++i) {
                     const auto &opt = *core.allOptionsResult[i].option;
@@ -93,7 +186,7 @@ namespace SysCmdLine {
             }
 
             case ParseResult::InvalidArgumentValue: {
-                auto d = errorArgument->d_func();
+                auto d = record.argument->d_func();
                 for (const auto &item : d->expectedValues) {
                     expectedValues.push_back(item.toString());
                 }
@@ -111,7 +204,7 @@ namespace SysCmdLine {
                 return {};
         }
 
-        auto input = errorPlaceholders[0];
+        const auto &input = record.token;
         auto suggestions = Utils::calcClosestTexts(expectedValues, input, int(input.size()) / 2);
         if (suggestions.empty())
             return {};
@@ -232,7 +325,7 @@ namespace SysCmdLine {
             noHelp ? Lists{nullptr, 0}
                    : getLists(
                          displayOptions, catalogueData->arg.data, catalogueData->arguments,
-                         core.argNameIndexes, int(d->arguments.size()),
+                         d->argumentNameIndexes, int(d->arguments.size()),
                          [](int i, const void *user) -> const Symbol * {
                              return &reinterpret_cast<decltype(d)>(user)->arguments[i]; //
                          },
@@ -248,7 +341,7 @@ namespace SysCmdLine {
                 ? Lists{nullptr, 0}
                 : getLists(
                       displayOptions, catalogueData->opt.data, catalogueData->options,
-                      core.allOptionTokenIndexes, int(core.allOptionsSize),
+                      core.optionTable->tokenIndexes, int(core.allOptionsSize),
                       [](int i, const void *user) -> const Symbol * {
                           return &(*reinterpret_cast<const decltype(reorderedOptions) *>(user))[i];
                       },
@@ -263,7 +356,7 @@ namespace SysCmdLine {
                              ? Lists{nullptr, 0}
                              : getLists(
                                    displayOptions, catalogueData->cmd.data, catalogueData->commands,
-                                   core.cmdNameIndexes, int(d->commands.size()),
+                                   d->commandNameIndexes, int(d->commands.size()),
                                    [](int i, const void *user) -> const Symbol * {
                                        return &reinterpret_cast<decltype(d)>(user)->commands[i]; //
                                    },
@@ -313,7 +406,8 @@ namespace SysCmdLine {
             maxWidth = 0;
         }
 
-        const auto &cmdDesc = d->detailedDescription.empty() ? d->desc : d->detailedDescription;
+        const auto &cmdDesc =
+            (d->detailedDescription.empty() ? d->desc : d->detailedDescription).text();
 
         // Get last
         int last = int(helpLayoutData->itemDataList.size()) - 1;
@@ -621,10 +715,28 @@ namespace SysCmdLine {
 
     std::string ParseResult::errorText() const {
         Q_D2(ParseResult);
-        if (d->error == NoError)
+        if (d->errors.empty())
+            return {};
+        return d->errorText(0);
+    }
+
+    int ParseResult::errorCount() const {
+        Q_D2(ParseResult);
+        return int(d->errors.size());
+    }
+
+    ParseResult::Error ParseResult::errorAt(int index) const {
+        Q_D2(ParseResult);
+        if (index < 0 || index >= int(d->errors.size()))
+            return NoError;
+        return d->errors[index].error;
+    }
+
+    std::string ParseResult::errorTextAt(int index) const {
+        Q_D2(ParseResult);
+        if (index < 0 || index >= int(d->errors.size()))
             return {};
-        return Utils::formatText(d->parser.d_func()->textProvider(Strings::ParseError, d->error),
-                                 d->errorPlaceholders);
+        return d->errorText(index);
     }
 
     std::string ParseResult::correctionText() const {
@@ -634,7 +746,7 @@ namespace SysCmdLine {
 
     std::string ParseResult::cancellationToken() const {
         Q_D2(ParseResult);
-        return d->cancellationToken;
+        return d->errors.empty() ? std::string() : d->errors.front().token;
     }
 
     Command ParseResult::command() const {
@@ -654,16 +766,18 @@ namespace SysCmdLine {
 
     int ParseResult::indexOfArgument(const std::string &name) const {
         Q_D2(ParseResult);
-        auto it = d->core.argNameIndexes.find(name);
-        if (it == d->core.argNameIndexes.end())
+        const auto &indexes = d->command->d_func()->argumentNameIndexes;
+        auto it = indexes.find(name);
+        if (it == indexes.end())
             return -1;
         return it->second.i;
     }
 
     int ParseResult::indexOfOption(const std::string &token) const {
         Q_D2(ParseResult);
-        auto it = d->core.allOptionTokenIndexes.find(token);
-        if (it == d->core.allOptionTokenIndexes.end())
+        const auto &indexes = d->core.optionTable->tokenIndexes;
+        auto it = indexes.find(token);
+        if (it == indexes.end())
             return -1;
         return it->second.i;
     }
@@ -675,9 +789,16 @@ namespace SysCmdLine {
 
         const auto &parserData = d->parser.d_func();
         const auto &displayOptions = parserData->displayOptions;
+        const auto &title = parserData->textProvider(Strings::Title, Strings::Error) + ": ";
+        std::string errorLines;
+        for (int i = 0; i < int(d->errors.size()); ++i) {
+            if (i > 0)
+                errorLines += "\n";
+            errorLines += title + d->errorText(i);
+        }
         d->showMessage(
             (displayOptions & Parser::SkipCorrection) ? std::string() : d->correctionText(), {},
-            parserData->textProvider(Strings::Title, Strings::Error) + ": " + errorText(), true);
+            errorLines, true);
     }
 
     void ParseResult::showHelpText() const {
@@ -712,6 +833,15 @@ namespace SysCmdLine {
         return args.empty() ? d->command->d_func()->arguments[index].defaultValue() : args.front();
     }
 
+    int ParseResult::ordinal(int index) const {
+        Q_D2(ParseResult);
+        if (index < 0 || index >= d->core.argSize)
+            return -1;
+        if (d->core.argResult[index].empty())
+            return d->command->d_func()->arguments[index].d_func()->defaultOrdinal;
+        return d->core.argOrdinals[index];
+    }
+
     OptionResult ParseResult::option(int index) const {
         Q_D2(ParseResult);
         if (index < 0 || index >= d->core.allOptionsSize)
@@ -719,6 +849,26 @@ namespace SysCmdLine {
         return {&d->core.allOptionsResult[index]};
     }
 
+    OptionResult ParseResult::commandOption(int index) const {
+        Q_D2(ParseResult);
+        if (index < 0 || index >= d->core.allOptionsSize - d->core.globalOptionsSize)
+            return {};
+        return {&d->core.allOptionsResult[d->core.globalOptionsSize + index]};
+    }
+
+    OptionResult ParseResult::rootOption(int index) const {
+        Q_D2(ParseResult);
+        if (!d->core.optionTable)
+            return {};
+        const auto &indexes = d->core.optionTable->rootOptionIndexes;
+        if (index < 0 || index >= int(indexes.size()))
+            return {};
+        auto i = indexes[index];
+        if (i < 0 || i >= d->core.allOptionsSize)
+            return {};
+        return {&d->core.allOptionsResult[i]};
+    }
+
     ParseResult::ParseResult(ParseResultPrivate *d) : SharedBase(d) {
     }
 
@@ -3,59 +3,83 @@
 
 #include "sharedbase_p.h"
 #include "parser.h"
+#include "parser_p.h"
 
 #include "map_p.h"
 
 namespace SysCmdLine {
 
+    // Buffers may be larger than the sizes in use when a result is reused by a session,
+    // the unused tail keeps its capacity for later parses
+
     struct ArgumentHolderData {
         int optionalArgIndex;
         int multiValueArgIndex;
-        GenericMap argNameIndexes; // name -> index of argument
-        int argSize;               // equal to `argumentCount()`
+        int argSize; // equal to `argumentCount()`
 
         ArgumentHolderData() : optionalArgIndex(-1), multiValueArgIndex(-1), argSize(0) {
         }
     };
 
+    // Value lists of some arguments and the expected value indexes of their first values
+    struct ValueSlots {
+        std::vector<Value> *values;
+        int *ordinals;
+        int *totalCounts; // value counts of all occurrences, null if not an option's
+    };
+
     struct OptionData : public ArgumentHolderData {
-        const Option *option;           // MUST BE SET
-        std::vector<Value> **argResult; // first: occurrence, second: arg index
-        int count;                      // occurrence times
+        const Option *option;                      // MUST BE SET
+        std::vector<std::vector<Value>> argResult; // occurrence * argSize + arg index
+        std::vector<int> ordinals;                 // same layout as `argResult`, -1 if none
+        int count;                                 // occurrence times
+        std::vector<int> totalCounts;              // arg index -> value count of all occurrences
 
-        OptionData() : option(nullptr), argResult(nullptr), count(0) {
+        OptionData() : option(nullptr), count(0) {
         }
 
-        ~OptionData() {
-            for (int i = 0; i < count; ++i) {
-                delete[] argResult[i];
-            }
-            delete[] argResult;
+        inline ValueSlots occurrence(int n) {
+            auto offset = size_t(n) * argSize;
+            return {argResult.data() + offset, ordinals.data() + offset, totalCounts.data()};
+        }
+
+        inline const std::vector<Value> &values(int n, int index) const {
+            return argResult[size_t(n) * argSize + index];
         }
 
         static const OptionData &sharedNull();
     };
 
     struct ParseResultData2 : public ArgumentHolderData {
-        std::vector<Value> *argResult;    // arg result
+        std::vector<std::vector<Value>> argResult; // arg result
+        std::vector<int> argOrdinals;              // arg index -> ordinal of the first value
 
-        OptionData *allOptionsResult;     // option result
-        int allOptionsSize;               // command option count + global option count
-        int globalOptionsSize;            // global option count
-        GenericMap allOptionTokenIndexes; // token -> index of `allOptionsResult`
+        std::vector<OptionData> allOptionsResult; // option result
+        int allOptionsSize;                       // command option count + global option count
+        int globalOptionsSize;                    // global option count
 
-        GenericMap cmdNameIndexes;        // name -> index of command
+        // options and token indexes of the command path, shared with the parser's cache
+        std::shared_ptr<const OptionTable> optionTable;
 
-        ~ParseResultData2() {
-            delete[] allOptionsResult;
-            delete[] argResult;
+        ParseResultData2() : allOptionsSize(0), globalOptionsSize(0) {
         }
     };
 
+    // The text of an error is formatted on demand
+    struct ErrorRecord {
+        ParseResult::Error error;
+        const Option *option;        // option being parsed
+        const Argument *argument;    // argument being parsed
+        const Option *relatedOption; // prior or colliding option
+        std::string detail;          // validator message or expected type
+        std::string token;           // cancellation token
+
+        std::vector<std::string> placeholders(int displayOptions) const;
+    };
+
     class ParseResultPrivate : public SharedBasePrivate {
     public:
-        ParseResultPrivate()
-            : error(ParseResult::NoError), errorOption(nullptr), errorArgument(nullptr) {
+        ParseResultPrivate() : error(ParseResult::NoError) {
         }
 
         ParseResultPrivate(const ParseResultPrivate &) = delete;
@@ -72,11 +96,8 @@ namespace SysCmdLine {
         std::vector<std::string> arguments;
 
         // error related
-        ParseResult::Error error;
-        std::vector<std::string> errorPlaceholders;
-        const Option *errorOption;
-        const Argument *errorArgument;
-        std::string cancellationToken;
+        ParseResult::Error error;        // first error
+        std::vector<ErrorRecord> errors; // all errors if collected, otherwise at most one
 
         // success results
         std::vector<int> stack;
@@ -86,6 +107,10 @@ namespace SysCmdLine {
 
         bool roleSet[5] = {};
 
+        // Clear results for reuse, keeping the capacity of buffers
+        void reset();
+
+        std::string errorText(int index) const;
         std::string correctionText() const;
 
         std::vector<Option> globalOptions() const;
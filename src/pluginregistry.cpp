@@ -0,0 +1,149 @@
+#include "pluginregistry.h"
+
+#include <filesystem>
+#include <fstream>
+#include <set>
+
+#ifdef _WIN32
+#  include <windows.h>
+#else
+#  include <dlfcn.h>
+#endif
+
+#include "command_p.h"
+#include "jsonreader_p.h"
+#include "parseresult.h"
+#include "system.h"
+
+namespace SysCmdLine {
+
+    namespace {
+
+        struct PluginInfo {
+            std::string name;
+            std::string desc;
+            std::string library;
+            std::string entry = "syscmdline_plugin_command";
+        };
+
+        PluginRegistry::Entry resolveEntry(const PluginInfo &plugin, std::string *errorMessage) {
+#ifdef _WIN32
+            auto handle = ::LoadLibraryW(utf8ToWide(plugin.library).data());
+            if (!handle) {
+                *errorMessage = "failed to load \"" + plugin.library + "\"";
+                return nullptr;
+            }
+            auto entry = ::GetProcAddress(handle, plugin.entry.data());
+            if (!entry) {
+                *errorMessage = "entry \"" + plugin.entry + "\" not found in \"" +
+                                plugin.library + "\"";
+                return nullptr;
+            }
+#else
+            auto handle = ::dlopen(plugin.library.data(), RTLD_NOW | RTLD_LOCAL);
+            if (!handle) {
+                *errorMessage = ::dlerror();
+                return nullptr;
+            }
+            auto entry = ::dlsym(handle, plugin.entry.data());
+            if (!entry) {
+                *errorMessage = ::dlerror();
+                return nullptr;
+            }
+#endif
+            return reinterpret_cast<PluginRegistry::Entry>(entry);
+        }
+
+        Command loadPlugin(const PluginInfo &plugin) {
+            Command cmd(plugin.name, plugin.desc);
+            std::string errorMessage;
+            if (auto entry = resolveEntry(plugin, &errorMessage)) {
+                entry(&cmd);
+                return cmd;
+            }
+
+            // Accept anything and report the failure when the command is run
+            cmd.addArgument(Argument("args", {}, false).nargs(Argument::Remainder));
+            cmd.setHandler([errorMessage](const ParseResult &) {
+                u8debug(MT_Critical, true, "%s\n", errorMessage.data());
+                return -1;
+            });
+            return cmd;
+        }
+
+    }
+
+    bool PluginRegistry::scan(const std::string &dir, Command *command,
+                              std::string *errorMessage) {
+        const auto &manifestPath = dir + "/plugins.json";
+        std::ifstream file(std::filesystem::path(
+#ifdef _WIN32
+                               utf8ToWide(manifestPath)
+#else
+                               manifestPath
+#endif
+                                   ),
+                           std::ios::binary);
+        if (!file.is_open()) {
+            if (errorMessage)
+                *errorMessage = "failed to open \"" + manifestPath + "\"";
+            return false;
+        }
+        std::string json((std::istreambuf_iterator<char>(file)),
+                         std::istreambuf_iterator<char>());
+
+        // Read the whole manifest before adding anything
+        std::vector<PluginInfo> plugins;
+        JsonReader reader(json.data(), json.size());
+        bool ok = reader.readObject([&reader, &plugins](const std::string &key) {
+            if (key != "plugins")
+                return reader.skipValue();
+            return reader.readArray([&reader, &plugins]() {
+                auto &plugin = plugins.emplace_back();
+                return reader.readObject([&reader, &plugin](const std::string &key) {
+                    if (key == "name")
+                        return reader.readString(&plugin.name);
+                    if (key == "description")
+                        return reader.readString(&plugin.desc);
+                    if (key == "library")
+                        return reader.readString(&plugin.library);
+                    if (key == "entry")
+                        return reader.readString(&plugin.entry);
+                    return reader.skipValue();
+                });
+            });
+        });
+        if (!ok || (!reader.atEnd() && !reader.fail("unexpected trailing characters"))) {
+            if (errorMessage)
+                *errorMessage = reader.error;
+            return false;
+        }
+
+        // The names are checked against the placeholders, which don't need to be built
+        const auto &existing = command->d_func()->commandNameIndexes;
+        std::set<std::string> names;
+        for (auto &plugin : plugins) {
+            if (plugin.name.empty() || plugin.library.empty()) {
+                if (errorMessage)
+                    *errorMessage = "plugin without a name or library";
+                return false;
+            }
+            if (existing.count(plugin.name) || !names.insert(plugin.name).second) {
+                if (errorMessage)
+                    *errorMessage = "plugin name \"" + plugin.name + "\" duplicated";
+                return false;
+            }
+            if (std::filesystem::path(plugin.library).is_relative()) {
+                plugin.library = dir + "/" + plugin.library;
+            }
+        }
+
+        for (const auto &plugin : plugins) {
+            command->addLazyCommand(plugin.name, plugin.desc, [plugin]() {
+                return loadPlugin(plugin); //
+            });
+        }
+        return true;
+    }
+
+}
@@ -0,0 +1,63 @@
+#include "schemabuilder_p.h"
+
+#include <stdexcept>
+
+namespace SysCmdLine {
+
+    void SchemaBuilder::setExpectedValues(ArgumentPrivate *d, std::vector<Value> &&values) {
+        d->expectedValues = std::move(values);
+        d->buildExpectedValueIndexes();
+    }
+
+    template <class F>
+    static bool check(F &&f, std::string *errorMessage) {
+        try {
+            f();
+        } catch (const std::runtime_error &e) {
+            *errorMessage = e.what();
+            return false;
+        }
+        return true;
+    }
+
+    bool SchemaBuilder::appendArgument(ArgumentHolderPrivate *d, Argument &&arg,
+                                       std::string *errorMessage) {
+        if (!check([&]() { d->checkAddedArgument(arg); }, errorMessage))
+            return false;
+        d->argumentNameIndexes[arg.d_func()->name] = ele(int(d->arguments.size()));
+        d->arguments.push_back(std::move(arg));
+        return true;
+    }
+
+    bool SchemaBuilder::appendOption(CommandPrivate *d, Option &&opt, const std::string &group,
+                                     std::string *errorMessage) {
+        if (!check([&]() { d->checkAddedOption(opt, group); }, errorMessage))
+            return false;
+        int groupId = d->exclusiveGroupId(group);
+        d->options.push_back(std::move(opt));
+        d->optionGroupIds.push_back(groupId);
+        return true;
+    }
+
+    bool SchemaBuilder::appendCommand(CommandPrivate *d, Command &&cmd,
+                                      std::string *errorMessage) {
+        if (!check([&]() { d->checkAddedCommand(cmd); }, errorMessage))
+            return false;
+        d->commandNameIndexes[cmd.d_func()->name] = ele(int(d->commands.size()));
+        d->commands.push_back(std::move(cmd));
+        return true;
+    }
+
+    bool SchemaBuilder::addCatalogueItems(CommandCatalogue *catalogue, CatalogueAdder add,
+                                          const std::string &name,
+                                          const std::vector<std::string> &items,
+                                          std::string *errorMessage) {
+        return check(
+            [&]() {
+                CommandCataloguePrivate::checkItems(items);
+                (catalogue->*add)(name, items);
+            },
+            errorMessage);
+    }
+
+}
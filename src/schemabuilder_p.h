@@ -0,0 +1,45 @@
+#ifndef SCHEMABUILDER_P_H
+#define SCHEMABUILDER_P_H
+
+#include "command_p.h"
+#include "option_p.h"
+
+namespace SysCmdLine {
+
+    // Builds symbols in place for the schema loaders, the symbols must not be shared until
+    // they are built, so that they can be modified without detaching
+    class SchemaBuilder {
+    public:
+        static inline ArgumentPrivate *data(Argument &arg) {
+            return const_cast<ArgumentPrivate *>(arg.d_func());
+        }
+
+        static inline OptionPrivate *data(Option &opt) {
+            return const_cast<OptionPrivate *>(opt.d_func());
+        }
+
+        static inline CommandPrivate *data(Command &cmd) {
+            return const_cast<CommandPrivate *>(cmd.d_func());
+        }
+
+        static void setExpectedValues(ArgumentPrivate *d, std::vector<Value> &&values);
+
+        // Append without copying the existing lists, the symbols are checked like the public
+        // API does in debug builds, and a failure is returned instead of being thrown
+        static bool appendArgument(ArgumentHolderPrivate *d, Argument &&arg,
+                                   std::string *errorMessage);
+        static bool appendOption(CommandPrivate *d, Option &&opt, const std::string &group,
+                                 std::string *errorMessage);
+        static bool appendCommand(CommandPrivate *d, Command &&cmd, std::string *errorMessage);
+
+        using CatalogueAdder = void (CommandCatalogue::*)(const std::string &,
+                                                          const std::vector<std::string> &);
+        static bool addCatalogueItems(CommandCatalogue *catalogue, CatalogueAdder add,
+                                      const std::string &name,
+                                      const std::vector<std::string> &items,
+                                      std::string *errorMessage);
+    };
+
+}
+
+#endif // SCHEMABUILDER_P_H
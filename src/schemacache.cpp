@@ -0,0 +1,623 @@
+#include "schemacache.h"
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+#ifndef _WIN32
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
+#endif
+
+#include "schemabuilder_p.h"
+#include "system.h"
+
+namespace SysCmdLine {
+
+    namespace {
+
+        // The image is a header followed by flat tables, all symbols refer to each other and
+        // to the strings by indexes, lists of indexes are slices of a shared index table
+        constexpr const uint32_t imageVersion = 3;
+        constexpr const uint32_t byteOrderMark = 0x01020304;
+        constexpr const uint32_t noIndex = 0xFFFFFFFF;
+
+        struct ImageHeader {
+            char magic[4];
+            uint32_t version;
+            uint32_t byteOrder;
+            uint32_t stringBytes;
+            uint64_t key;
+            uint32_t stringCount;
+            uint32_t valueCount;
+            uint32_t argumentCount;
+            uint32_t optionCount;
+            uint32_t commandCount;
+            uint32_t catalogueCount;
+            uint32_t indexCount;
+            uint32_t reserved;
+        };
+
+        struct StringEntry {
+            uint32_t offset;
+            uint32_t size;
+        };
+
+        struct ValueEntry {
+            uint32_t type;
+            uint32_t reserved;
+            uint64_t bits; // string index if it's a string
+        };
+
+        struct ArgumentEntry {
+            uint32_t name;
+            uint32_t desc;
+            uint32_t displayName;
+            uint8_t required;
+            uint8_t number;
+            uint8_t reserved[2];
+            uint32_t defaultValue;  // value index
+            uint32_t expectedFirst; // value indexes in the index table
+            uint32_t expectedCount;
+        };
+
+        struct OptionEntry {
+            uint32_t desc;
+            uint8_t role;
+            uint8_t required;
+            uint8_t shortMatchRule;
+            uint8_t priorLevel;
+            uint8_t global;
+            uint8_t reserved[3];
+            int32_t maxOccurrence;
+            uint32_t tokenFirst; // string indexes in the index table
+            uint32_t tokenCount;
+            uint32_t argumentFirst;
+            uint32_t argumentCount;
+        };
+
+        struct CommandEntry {
+            uint32_t name;
+            uint32_t desc;
+            uint32_t detailedDescription;
+            uint32_t version;
+            uint32_t argumentFirst;
+            uint32_t argumentCount;
+            uint32_t optionFirst;
+            uint32_t optionCount;
+            uint32_t groupFirst; // group name of each option in the index table, may be none
+            uint32_t commandFirst;
+            uint32_t commandCount;
+            uint32_t catalogueFirst;
+            uint32_t catalogueCount;
+        };
+
+        struct CatalogueEntry {
+            uint32_t kind; // 0: arguments, 1: options, 2: commands
+            uint32_t name;
+            uint32_t itemFirst; // string indexes in the index table
+            uint32_t itemCount;
+        };
+
+        class ImageWriter {
+        public:
+            std::vector<StringEntry> strings;
+            std::string stringBytes;
+            GenericMap stringIndexes;
+            std::vector<ValueEntry> values;
+            std::vector<ArgumentEntry> arguments;
+            std::vector<OptionEntry> options;
+            std::vector<CommandEntry> commands;
+            std::vector<CatalogueEntry> catalogues;
+            std::vector<uint32_t> indexes;
+
+            uint32_t addString(const std::string &s) {
+                auto it = stringIndexes.find(s);
+                if (it != stringIndexes.end()) {
+                    return uint32_t(it->second.i);
+                }
+                auto idx = uint32_t(strings.size());
+                strings.push_back({uint32_t(stringBytes.size()), uint32_t(s.size())});
+                stringBytes += s;
+                stringIndexes[s] = ele(int(idx));
+                return idx;
+            }
+
+            uint32_t addValue(const Value &val) {
+                ValueEntry entry = {uint32_t(val.type()), 0, 0};
+                switch (val.type()) {
+                    case Value::Bool:
+                        entry.bits = val.toBool();
+                        break;
+                    case Value::Int:
+                        entry.bits = uint64_t(int64_t(val.toInt()));
+                        break;
+                    case Value::Int64:
+                        entry.bits = uint64_t(val.toInt64());
+                        break;
+                    case Value::Double: {
+                        double d = val.toDouble();
+                        std::memcpy(&entry.bits, &d, sizeof(d));
+                        break;
+                    }
+                    case Value::String:
+                        entry.bits = addString(val.toString());
+                        break;
+                    default:
+                        break;
+                }
+                values.push_back(entry);
+                return uint32_t(values.size() - 1);
+            }
+
+            uint32_t addArguments(const std::vector<Argument> &args) {
+                auto first = uint32_t(arguments.size());
+                for (const auto &arg : args) {
+                    const auto &d = arg.d_func();
+                    ArgumentEntry entry = {};
+                    entry.name = addString(d->name);
+                    entry.desc = addString(d->desc.data());
+                    entry.displayName = addString(d->displayName);
+                    entry.required = d->required;
+                    entry.number = uint8_t(d->number);
+                    entry.defaultValue = addValue(d->defaultValue);
+                    entry.expectedFirst = uint32_t(indexes.size());
+                    entry.expectedCount = uint32_t(d->expectedValues.size());
+                    for (const auto &val : d->expectedValues) {
+                        auto idx = addValue(val);
+                        indexes.push_back(idx);
+                    }
+                    arguments.push_back(entry);
+                }
+                return first;
+            }
+
+            uint32_t addStrings(const std::vector<std::string> &list) {
+                auto first = uint32_t(indexes.size());
+                for (const auto &s : list) {
+                    auto idx = addString(s);
+                    indexes.push_back(idx);
+                }
+                return first;
+            }
+
+            void addCatalogue(CommandEntry &entry, const CommandCataloguePrivate *d) {
+                entry.catalogueFirst = uint32_t(catalogues.size());
+                const auto &addKind = [this](uint32_t kind, const GenericMap &map,
+                                             const StringList &keys) {
+                    for (const auto &key : keys) {
+                        const auto &items = *map.at(key).sl;
+                        CatalogueEntry cat = {kind, addString(key), 0, uint32_t(items.size())};
+                        cat.itemFirst = addStrings(items);
+                        catalogues.push_back(cat);
+                    }
+                };
+                addKind(0, d->arg.data, d->arguments);
+                addKind(1, d->opt.data, d->options);
+                addKind(2, d->cmd.data, d->commands);
+                entry.catalogueCount = uint32_t(catalogues.size()) - entry.catalogueFirst;
+            }
+
+            // Commands are stored in breadth-first order, so that the children are adjacent
+            void addCommandTree(const Command &root) {
+                std::vector<const Command *> nodes = {&root};
+                commands.emplace_back();
+                for (size_t i = 0; i < nodes.size(); ++i) {
+                    const auto &d = nodes[i]->d_func();
+                    d->materialize(); // the image can't hold a factory
+                    CommandEntry entry = {};
+                    entry.name = addString(d->name);
+                    entry.desc = addString(d->desc.data());
+                    entry.detailedDescription = addString(d->detailedDescription.data());
+                    entry.version = addString(d->version);
+                    entry.argumentCount = uint32_t(d->arguments.size());
+                    entry.argumentFirst = addArguments(d->arguments);
+
+                    entry.optionFirst = uint32_t(options.size());
+                    entry.optionCount = uint32_t(d->options.size());
+                    for (const auto &opt : d->options) {
+                        const auto &dd = opt.d_func();
+                        OptionEntry optEntry = {};
+                        optEntry.desc = addString(dd->desc.data());
+                        optEntry.role = uint8_t(dd->role);
+                        optEntry.required = dd->required;
+                        optEntry.shortMatchRule = uint8_t(dd->shortMatchRule);
+                        optEntry.priorLevel = uint8_t(dd->priorLevel);
+                        optEntry.global = dd->global;
+                        optEntry.maxOccurrence = dd->maxOccurrence;
+                        optEntry.tokenCount = uint32_t(dd->tokens.size());
+                        optEntry.tokenFirst = addStrings(dd->tokens);
+                        optEntry.argumentCount = uint32_t(dd->arguments.size());
+                        optEntry.argumentFirst = addArguments(dd->arguments);
+                        options.push_back(optEntry);
+                    }
+
+                    entry.groupFirst = uint32_t(indexes.size());
+                    for (const auto &groupId : d->optionGroupIds) {
+                        auto idx = groupId < 0 ? noIndex : addString(d->optionGroups[groupId]);
+                        indexes.push_back(idx);
+                    }
+
+                    addCatalogue(entry, d->catalogue.d_func());
+
+                    entry.commandFirst = uint32_t(nodes.size());
+                    entry.commandCount = uint32_t(d->commands.size());
+                    for (const auto &cmd : d->commands) {
+                        nodes.push_back(&cmd);
+                        commands.emplace_back();
+                    }
+                    commands[i] = entry;
+                }
+            }
+
+            template <class T>
+            static void write(std::ofstream &file, const std::vector<T> &vec) {
+                file.write(reinterpret_cast<const char *>(vec.data()),
+                           std::streamsize(vec.size() * sizeof(T)));
+            }
+
+            bool save(const std::string &path, uint64_t key) const {
+                ImageHeader header{};
+                std::memcpy(header.magic, "SCMD", 4);
+                header.version = imageVersion;
+                header.byteOrder = byteOrderMark;
+                header.stringBytes = uint32_t(stringBytes.size());
+                header.key = key;
+                header.stringCount = uint32_t(strings.size());
+                header.valueCount = uint32_t(values.size());
+                header.argumentCount = uint32_t(arguments.size());
+                header.optionCount = uint32_t(options.size());
+                header.commandCount = uint32_t(commands.size());
+                header.catalogueCount = uint32_t(catalogues.size());
+                header.indexCount = uint32_t(indexes.size());
+
+                std::ofstream file(std::filesystem::path(
+#ifdef _WIN32
+                                       utf8ToWide(path)
+#else
+                                       path
+#endif
+                                           ),
+                                   std::ios::binary | std::ios::trunc);
+                if (!file.is_open()) {
+                    return false;
+                }
+                file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+                write(file, values);
+                write(file, strings);
+                write(file, arguments);
+                write(file, options);
+                write(file, commands);
+                write(file, catalogues);
+                write(file, indexes);
+                file.write(stringBytes.data(), std::streamsize(stringBytes.size()));
+                return file.good();
+            }
+        };
+
+        // Maps the file if possible, otherwise reads it
+        class ImageFile {
+        public:
+            ~ImageFile() {
+#ifndef _WIN32
+                if (mapped) {
+                    ::munmap(const_cast<char *>(data), size);
+                }
+#endif
+            }
+
+            bool open(const std::string &path) {
+#ifndef _WIN32
+                int fd = ::open(path.data(), O_RDONLY);
+                if (fd < 0) {
+                    return false;
+                }
+                struct stat st;
+                if (::fstat(fd, &st) == 0 && st.st_size > 0) {
+                    auto addr = ::mmap(nullptr, size_t(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+                    if (addr != MAP_FAILED) {
+                        data = static_cast<const char *>(addr);
+                        size = size_t(st.st_size);
+                        mapped = true;
+                    }
+                }
+                ::close(fd);
+                if (mapped) {
+                    return true;
+                }
+#endif
+                std::ifstream file(std::filesystem::path(
+#ifdef _WIN32
+                                       utf8ToWide(path)
+#else
+                                       path
+#endif
+                                           ),
+                                   std::ios::binary);
+                if (!file.is_open()) {
+                    return false;
+                }
+                buffer.assign(std::istreambuf_iterator<char>(file),
+                              std::istreambuf_iterator<char>());
+                data = buffer.data();
+                size = buffer.size();
+                return true;
+            }
+
+            const char *data = nullptr;
+            size_t size = 0;
+
+        private:
+            bool mapped = false;
+            std::vector<char> buffer;
+        };
+
+        // Rebuilds the symbols, any index out of range marks the image as broken
+        class ImageReader {
+        public:
+            bool init(const char *data, size_t size, uint64_t key) {
+                if (size < sizeof(ImageHeader))
+                    return false;
+                header = reinterpret_cast<const ImageHeader *>(data);
+                if (std::memcmp(header->magic, "SCMD", 4) != 0 ||
+                    header->version != imageVersion || header->byteOrder != byteOrderMark ||
+                    header->key != key || header->commandCount == 0) {
+                    return false;
+                }
+
+                size_t offset = sizeof(ImageHeader);
+                const auto &section = [&](auto *&ptr, uint32_t count) {
+                    ptr = reinterpret_cast<std::remove_reference_t<decltype(ptr)>>(data + offset);
+                    offset += size_t(count) * sizeof(*ptr);
+                };
+                section(values, header->valueCount);
+                section(strings, header->stringCount);
+                section(arguments, header->argumentCount);
+                section(options, header->optionCount);
+                section(commands, header->commandCount);
+                section(catalogues, header->catalogueCount);
+                section(indexes, header->indexCount);
+                stringBytes = data + offset;
+                return offset + header->stringBytes <= size;
+            }
+
+            inline bool check(uint32_t first, uint32_t count, uint32_t total) {
+                if (first > total || count > total - first)
+                    ok = false;
+                return ok;
+            }
+
+            std::string str(uint32_t idx) {
+                if (!check(idx, 1, header->stringCount))
+                    return {};
+                const auto &entry = strings[idx];
+                if (!check(entry.offset, entry.size, header->stringBytes))
+                    return {};
+                return {stringBytes + entry.offset, entry.size};
+            }
+
+            // Descriptions are stored encoded, and only decoded when they're rendered
+            CompressedText text(uint32_t idx) {
+                auto res = CompressedText::fromData(str(idx));
+                if (!res.isValid())
+                    ok = false;
+                return res;
+            }
+
+            // Enums are stored as bytes, a value behind the last one marks the image as broken
+            template <class T>
+            T enumValue(uint8_t byte, T last) {
+                if (byte > last) {
+                    ok = false;
+                    return T(0);
+                }
+                return T(byte);
+            }
+
+            Value value(uint32_t idx) {
+                if (!check(idx, 1, header->valueCount))
+                    return {};
+                const auto &entry = values[idx];
+                switch (entry.type) {
+                    case Value::Bool:
+                        return entry.bits != 0;
+                    case Value::Int:
+                        return int(int64_t(entry.bits));
+                    case Value::Int64:
+                        return int64_t(entry.bits);
+                    case Value::Double: {
+                        double d;
+                        std::memcpy(&d, &entry.bits, sizeof(d));
+                        return d;
+                    }
+                    case Value::String:
+                        return str(uint32_t(entry.bits));
+                    default:
+                        break;
+                }
+                return {};
+            }
+
+            Argument argument(uint32_t idx) {
+                const auto &entry = arguments[idx];
+                Argument arg(str(entry.name), {}, entry.required, value(entry.defaultValue));
+                auto d = SchemaBuilder::data(arg);
+                d->desc = text(entry.desc);
+                d->displayName = str(entry.displayName);
+                d->number = enumValue(entry.number, Argument::Remainder);
+                if (entry.expectedCount > 0 &&
+                    check(entry.expectedFirst, entry.expectedCount, header->indexCount)) {
+                    std::vector<Value> expectedValues;
+                    expectedValues.reserve(entry.expectedCount);
+                    for (uint32_t i = 0; i < entry.expectedCount; ++i) {
+                        expectedValues.push_back(value(indexes[entry.expectedFirst + i]));
+                    }
+                    SchemaBuilder::setExpectedValues(d, std::move(expectedValues));
+                }
+                return arg;
+            }
+
+            void addArguments(ArgumentHolderPrivate *d, uint32_t first, uint32_t count) {
+                if (!check(first, count, header->argumentCount))
+                    return;
+                d->arguments.reserve(count);
+                for (uint32_t i = 0; i < count && ok; ++i) {
+                    if (!SchemaBuilder::appendArgument(d, argument(first + i), &checkError))
+                        ok = false;
+                }
+            }
+
+            std::vector<std::string> strs(uint32_t first, uint32_t count) {
+                std::vector<std::string> res;
+                if (!check(first, count, header->indexCount))
+                    return res;
+                res.reserve(count);
+                for (uint32_t i = 0; i < count; ++i) {
+                    res.push_back(str(indexes[first + i]));
+                }
+                return res;
+            }
+
+            Option option(uint32_t idx) {
+                const auto &entry = options[idx];
+                Option opt(enumValue(entry.role, Option::Help),
+                           strs(entry.tokenFirst, entry.tokenCount));
+                auto d = SchemaBuilder::data(opt);
+                d->desc = text(entry.desc);
+                d->required = entry.required;
+                d->shortMatchRule = enumValue(entry.shortMatchRule, Option::ShortMatchAll);
+                d->priorLevel = enumValue(entry.priorLevel, Option::ExclusiveToAll);
+                d->global = entry.global;
+                d->maxOccurrence = entry.maxOccurrence;
+                addArguments(d, entry.argumentFirst, entry.argumentCount);
+                return opt;
+            }
+
+            CommandCatalogue catalogue(uint32_t first, uint32_t count) {
+                CommandCatalogue res;
+                if (!check(first, count, header->catalogueCount))
+                    return res;
+                for (uint32_t i = first; i < first + count && ok; ++i) {
+                    const auto &entry = catalogues[i];
+                    auto name = str(entry.name);
+                    auto items = strs(entry.itemFirst, entry.itemCount);
+                    SchemaBuilder::CatalogueAdder add;
+                    switch (entry.kind) {
+                        case 0:
+                            add = &CommandCatalogue::addArguments;
+                            break;
+                        case 1:
+                            add = &CommandCatalogue::addOptions;
+                            break;
+                        default:
+                            add = &CommandCatalogue::addCommands;
+                            break;
+                    }
+                    if (!SchemaBuilder::addCatalogueItems(&res, add, name, items, &checkError))
+                        ok = false;
+                }
+                return res;
+            }
+
+            Command command(uint32_t idx, std::vector<std::string> &path,
+                            const SchemaCache::HandlerProvider &handlerProvider) {
+                const auto &entry = commands[idx];
+                Command cmd(str(entry.name));
+                auto d = SchemaBuilder::data(cmd);
+                d->desc = text(entry.desc);
+                d->detailedDescription = text(entry.detailedDescription);
+                d->version = str(entry.version);
+                addArguments(d, entry.argumentFirst, entry.argumentCount);
+
+                if (check(entry.optionFirst, entry.optionCount, header->optionCount) &&
+                    check(entry.groupFirst, entry.optionCount, header->indexCount)) {
+                    d->options.reserve(entry.optionCount);
+                    for (uint32_t i = 0; i < entry.optionCount && ok; ++i) {
+                        auto group = indexes[entry.groupFirst + i];
+                        if (!SchemaBuilder::appendOption(
+                                d, option(entry.optionFirst + i),
+                                group == noIndex ? std::string() : str(group), &checkError))
+                            ok = false;
+                    }
+                }
+
+                if (entry.catalogueCount > 0) {
+                    d->catalogue = catalogue(entry.catalogueFirst, entry.catalogueCount);
+                }
+
+                path.push_back(d->name);
+                if (handlerProvider) {
+                    d->handler = handlerProvider(path);
+                }
+
+                // Children are always stored behind the parent
+                if (entry.commandFirst > idx &&
+                    check(entry.commandFirst, entry.commandCount, header->commandCount)) {
+                    d->commands.reserve(entry.commandCount);
+                    for (uint32_t i = 0; i < entry.commandCount && ok; ++i) {
+                        if (!SchemaBuilder::appendCommand(
+                                d, command(entry.commandFirst + i, path, handlerProvider),
+                                &checkError))
+                            ok = false;
+                    }
+                } else if (entry.commandCount > 0) {
+                    ok = false;
+                }
+                path.pop_back();
+                return cmd;
+            }
+
+            const ImageHeader *header = nullptr;
+            const ValueEntry *values = nullptr;
+            const StringEntry *strings = nullptr;
+            const ArgumentEntry *arguments = nullptr;
+            const OptionEntry *options = nullptr;
+            const CommandEntry *commands = nullptr;
+            const CatalogueEntry *catalogues = nullptr;
+            const uint32_t *indexes = nullptr;
+            const char *stringBytes = nullptr;
+            bool ok = true;
+            std::string checkError; // a symbol being added fails the checks
+        };
+
+    }
+
+    bool SchemaCache::save(const Command &command, const std::string &path, uint64_t key) {
+        ImageWriter writer;
+        writer.addCommandTree(command);
+        return writer.save(path, key);
+    }
+
+    bool SchemaCache::load(const std::string &path, uint64_t key, Command *command,
+                           const HandlerProvider &handlerProvider) {
+        ImageFile file;
+        ImageReader reader;
+        if (!file.open(path) || !reader.init(file.data, file.size, key)) {
+            return false;
+        }
+
+        std::vector<std::string> commandPath;
+        auto res = reader.command(0, commandPath, handlerProvider);
+        if (!reader.ok) {
+            return false;
+        }
+        *command = std::move(res);
+        return true;
+    }
+
+    std::string SchemaCache::defaultPath() {
+        return appDirectory() + "/" + appName() + ".schema";
+    }
+
+    uint64_t SchemaCache::fingerprint(const std::string &s) {
+        uint64_t hash = 14695981039346656037ull;
+        for (const auto &ch : s) {
+            hash ^= uint64_t((unsigned char) ch);
+            hash *= 1099511628211ull;
+        }
+        return hash;
+    }
+
+}
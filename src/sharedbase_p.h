@@ -12,8 +12,8 @@ namespace SysCmdLine {
 
         virtual SharedBasePrivate *clone() const = 0;
 
-        // Declare basic copy constructor
-        SharedBasePrivate(const SharedBasePrivate &) : ref(0) {
+        // A copy is a new object owned by the one who made it, the count isn't copied
+        SharedBasePrivate(const SharedBasePrivate &) : ref(1) {
         }
 
         SharedBasePrivate &operator=(const SharedBasePrivate &) = delete;
@@ -22,7 +22,7 @@ namespace SysCmdLine {
     */
     std::string Symbol::description() const {
         Q_D2(Symbol);
-        return d->desc;
+        return d->desc.text();
     }
 
     /*!
@@ -5,6 +5,7 @@
 
 #include "symbol.h"
 #include "sharedbase_p.h"
+#include "compressedtext_p.h"
 
 namespace SysCmdLine {
 
@@ -14,7 +15,7 @@ namespace SysCmdLine {
 
     public:
         Symbol::SymbolType type;
-        std::string desc;
+        CompressedText desc;
         Symbol::HelpProvider helpProvider;
     };
 
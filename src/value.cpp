@@ -1,8 +1,16 @@
 #include "value.h"
 
+#include "value_p.h"
+
 #include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <limits>
 
-#include "utils_p.h"
+#ifndef __cpp_lib_to_chars
+#  include <cerrno>
+#  include <cstdlib>
+#endif
 
 namespace SysCmdLine {
 
@@ -217,105 +225,267 @@ namespace SysCmdLine {
         return !(*this == other);
     }
 
-    static void determineBase(std::string &s, int &base, int &f) {
-        if (s.front() == '+') {
-            s = s.substr(1);
-        } else if (s.front() == '-') {
-            f = -1;
-            s = s.substr(1);
+    static bool equalsIgnoreCase(const char *s, size_t size, const char *literal,
+                                 size_t literalSize) {
+        if (size != literalSize)
+            return false;
+        for (size_t i = 0; i < size; ++i) {
+            if (std::tolower(static_cast<unsigned char>(s[i])) != literal[i])
+                return false;
+        }
+        return true;
+    }
+
+    Value::ConversionError parseBool(const char *s, size_t size, bool *out, size_t *errorPos) {
+        if (size == 0) {
+            *errorPos = 0;
+            return Value::EmptyString;
+        }
+        if (equalsIgnoreCase(s, size, True_Literal, sizeof(True_Literal) - 1)) {
+            *out = true;
+            return Value::NoConversionError;
         }
-        if (s.size() > 2 && s.front() == '0') {
-            switch (s.at(1)) {
+        if (equalsIgnoreCase(s, size, False_Literal, sizeof(False_Literal) - 1)) {
+            *out = false;
+            return Value::NoConversionError;
+        }
+        *errorPos = 0;
+        return Value::InvalidCharacter;
+    }
+
+    Value::ConversionError parseInteger(const char *s, size_t size, int64_t min, int64_t max,
+                                        int64_t *out, size_t *errorPos) {
+        if (size == 0) {
+            *errorPos = 0;
+            return Value::EmptyString;
+        }
+
+        const char *p = s;
+        const char *end = s + size;
+
+        // Leading whitespace is skipped like `std::stoll` did
+        while (p != end && std::isspace(static_cast<unsigned char>(*p))) {
+            p++;
+        }
+        if (p == end) {
+            *errorPos = size;
+            return Value::InvalidCharacter;
+        }
+
+        // Determine sign
+        bool negative = false;
+        if (*p == '+') {
+            p++;
+        } else if (*p == '-') {
+            negative = true;
+            p++;
+        }
+
+        // Determine base
+        int base = 10;
+        if (end - p > 2 && p[0] == '0') {
+            switch (p[1]) {
                 case 'x':
                 case 'X':
-                    s = s.substr(2);
                     base = 16;
+                    p += 2;
                     break;
                 case 'b':
                 case 'B':
-                    s = s.substr(2);
                     base = 2;
+                    p += 2;
                     break;
                 case 'o':
                 case 'O':
-                    s = s.substr(2);
                     base = 8;
+                    p += 2;
                     break;
                 case 'd':
                 case 'D':
-                    s = s.substr(2);
+                    p += 2;
                     break;
                 default:
                     break;
             }
         }
+
+        if (p == end) {
+            *errorPos = size;
+            return Value::InvalidCharacter;
+        }
+
+        // The magnitude is parsed as unsigned, `std::from_chars` rejects any sign here
+        uint64_t magnitude;
+        auto res = std::from_chars(p, end, magnitude, base);
+        if (res.ec == std::errc::invalid_argument) {
+            *errorPos = size_t(p - s);
+            return Value::InvalidCharacter;
+        }
+        if (res.ptr != end) {
+            *errorPos = size_t(res.ptr - s);
+            return Value::InvalidCharacter;
+        }
+        if (res.ec == std::errc::result_out_of_range) {
+            *errorPos = 0;
+            return Value::OutOfRange;
+        }
+
+        if (negative) {
+            // -(min + 1) + 1 avoids overflow when negating the minimum
+            if (magnitude > uint64_t(-(min + 1)) + 1) {
+                *errorPos = 0;
+                return Value::OutOfRange;
+            }
+            *out = magnitude == 0 ? 0 : -int64_t(magnitude - 1) - 1;
+        } else {
+            if (magnitude > uint64_t(max)) {
+                *errorPos = 0;
+                return Value::OutOfRange;
+            }
+            *out = int64_t(magnitude);
+        }
+        return Value::NoConversionError;
+    }
+
+    Value::ConversionError parseDouble(const char *s, size_t size, double *out,
+                                       size_t *errorPos) {
+        if (size == 0) {
+            *errorPos = 0;
+            return Value::EmptyString;
+        }
+
+        const char *p = s;
+        const char *end = s + size;
+
+        // Leading whitespace is skipped like `std::stod` did
+        while (p != end && std::isspace(static_cast<unsigned char>(*p))) {
+            p++;
+        }
+        if (p == end) {
+            *errorPos = size;
+            return Value::InvalidCharacter;
+        }
+
+        double val;
+#ifdef __cpp_lib_to_chars
+        // `std::from_chars` takes neither the plus sign nor the prefix of a hex float, so both
+        // signs are handled here
+        bool negative = false;
+        if (*p == '+' || *p == '-') {
+            negative = *p == '-';
+            p++;
+        }
+        auto format = std::chars_format::general;
+        if (end - p > 2 && p[0] == '0' && (p[1] == 'x' || p[1] == 'X')) {
+            format = std::chars_format::hex;
+            p += 2;
+        }
+        if (p == end || *p == '+' || *p == '-') {
+            *errorPos = size_t(p - s);
+            return Value::InvalidCharacter;
+        }
+
+        auto res = std::from_chars(p, end, val, format);
+        if (res.ec == std::errc::invalid_argument) {
+            *errorPos = size_t(p - s);
+            return Value::InvalidCharacter;
+        }
+        if (res.ptr != end) {
+            *errorPos = size_t(res.ptr - s);
+            return Value::InvalidCharacter;
+        }
+        if (res.ec == std::errc::result_out_of_range) {
+            *errorPos = 0;
+            return Value::OutOfRange;
+        }
+        if (negative) {
+            val = -val;
+        }
+#else
+        // Fallback for standard libraries without floating point `std::from_chars`
+        std::string str(p, end);
+        char *strEnd;
+        errno = 0;
+        val = std::strtod(str.data(), &strEnd);
+        if (strEnd == str.data()) {
+            *errorPos = size_t(p - s);
+            return Value::InvalidCharacter;
+        }
+        if (strEnd != str.data() + str.size()) {
+            *errorPos = size_t(p - s) + size_t(strEnd - str.data());
+            return Value::InvalidCharacter;
+        }
+        if (errno == ERANGE) {
+            *errorPos = 0;
+            return Value::OutOfRange;
+        }
+#endif
+        *out = val;
+        return Value::NoConversionError;
     }
 
     Value Value::fromString(const std::string &s, Value::Type type) {
+        return fromString(s.data(), s.size(), type);
+    }
+
+    Value Value::fromString(const char *s, size_t size, Value::Type type,
+                            Value::ConversionError *error, size_t *errorPos) {
         Value res;
+        ConversionError err = NoConversionError;
+        size_t pos = 0;
         switch (type) {
             case Bool: {
-                if (Utils::toLower(s) == True_Literal) {
-                    res = true;
-                } else if (Utils::toLower(s) == False_Literal) {
-                    res = false;
+                bool b;
+                if ((err = parseBool(s, size, &b, &pos)) == NoConversionError) {
+                    res = b;
                 }
                 break;
             }
 
             case Int: {
-                std::string::size_type idx;
-                try {
-                    std::string s1 = s;
-                    int base = 10;
-                    int f = 1;
-                    determineBase(s1, base, f);
-                    res = std::stoi(s1, &idx, base) * f;
-                    if (idx < s1.size()) {
-                        res = {};
-                    }
-                } catch (...) {
+                int64_t l;
+                if ((err = parseInteger(s, size, std::numeric_limits<int>::min(),
+                                        std::numeric_limits<int>::max(), &l, &pos)) ==
+                    NoConversionError) {
+                    res = int(l);
                 }
                 break;
             }
 
             case Int64: {
-                std::string::size_type idx;
-                try {
-                    std::string s1 = s;
-                    int base = 10;
-                    int f = 1;
-                    determineBase(s1, base, f);
-                    res = (int64_t) std::stoll(s1, &idx, base) * f;
-                    if (idx < s1.size()) {
-                        res = {};
-                    }
-                } catch (...) {
+                int64_t l;
+                if ((err = parseInteger(s, size, std::numeric_limits<int64_t>::min(),
+                                        std::numeric_limits<int64_t>::max(), &l, &pos)) ==
+                    NoConversionError) {
+                    res = l;
                 }
                 break;
             }
 
             case Double: {
-                std::string::size_type idx;
-                try {
-                    res = std::stod(s, &idx);
-                    if (idx < s.size()) {
-                        res = {};
-                    }
-                } catch (...) {
+                double d;
+                if ((err = parseDouble(s, size, &d, &pos)) == NoConversionError) {
+                    res = d;
                 }
                 break;
             }
 
             case String: {
-                if (!s.empty()) {
-                    res = s;
+                if (size > 0) {
+                    res = Value(s, int(size));
+                } else {
+                    err = EmptyString;
                 }
                 break;
             }
             default:
+                err = UnsupportedType;
                 break;
         }
+        if (error)
+            *error = err;
+        if (errorPos)
+            *errorPos = pos;
         return res;
     }
 
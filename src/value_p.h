@@ -0,0 +1,24 @@
+#ifndef VALUE_P_H
+#define VALUE_P_H
+
+#include "value.h"
+
+namespace SysCmdLine {
+
+    // Conversion engine of `Value::fromString`, never allocates or throws.
+    // s:        input characters, not necessarily null-terminated
+    // size:     input size
+    // out:      result if succeeds, unchanged if fails
+    // errorPos: position of the first invalid character if fails
+    // ->        error code
+    Value::ConversionError parseBool(const char *s, size_t size, bool *out, size_t *errorPos);
+
+    Value::ConversionError parseInteger(const char *s, size_t size, int64_t min, int64_t max,
+                                        int64_t *out, size_t *errorPos);
+
+    Value::ConversionError parseDouble(const char *s, size_t size, double *out,
+                                       size_t *errorPos);
+
+}
+
+#endif // VALUE_P_H
@@ -1,7 +1,14 @@
 #include <iostream>
 #include <cassert>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
 
 #include <syscmdline/parser.h>
+#include <syscmdline/getoptlong.h>
+#include <syscmdline/schemacache.h>
+#include <syscmdline/jsonschema.h>
+#include <syscmdline/pluginregistry.h>
 #include <syscmdline/system.h>
 
 using namespace SysCmdLine;
@@ -73,6 +80,176 @@ int main(int argc, char *argv[]) {
             assert(res.error() == ParseResult::ArgumentTypeMismatch);
         }
         std::cout << "Argument type mismatch: OK" << std::endl;
+
+        {
+            Parser parser(cmd);
+            ParseResult res = parser.parse({"cmd", "3"});
+            assert(res.error() == ParseResult::NoError);
+            assert(res.ordinal("arg1") == 2);
+            assert(res.ordinal("arg2") == -1);
+        }
+        std::cout << "Expected value ordinal: OK" << std::endl;
+
+        Command codecCmd("cmd");
+        codecCmd.addArgument(Argument("codec").expect({"H264", "HEVC", 1, 2.5}));
+
+        {
+            Parser parser(codecCmd);
+            assert(parser.parse({"cmd", "hevc"}).error() == ParseResult::InvalidArgumentValue);
+
+            ParseResult res = parser.parse({"cmd", "hevc"}, Parser::IgnoreValueCase);
+            assert(res.error() == ParseResult::NoError);
+            assert(res.value("codec") == "HEVC");
+            assert(res.ordinal("codec") == 1);
+
+            assert(parser.parse({"cmd", "0x1"}).ordinal("codec") == 2);
+            assert(parser.parse({"cmd", "2.5"}).ordinal("codec") == 3);
+        }
+        std::cout << "Case-insensitive expected value: OK" << std::endl;
+
+        {
+            Command cmd("cmd");
+            cmd.addArgument(Argument("level", {}, false, "high").expect({"low", "high"}));
+            cmd.addOption(
+                Option("-c").arg(Argument("codec").expect({"H264", "HEVC"})).short_match().multi());
+
+            Parser parser(cmd);
+            ParseResult res = parser.parse({"cmd", "-c", "HEVC", "-cH264"});
+            assert(res.error() == ParseResult::NoError);
+            assert(res.ordinal("level") == 1);
+            assert(res.option("-c").ordinal(0, 0) == 1);
+            assert(res.option("-c").ordinal(0, 1) == 0);
+            assert(res.option("-c").ordinal(0, 2) == -1);
+
+            res = parser.parse({"cmd", "low"});
+            assert(res.ordinal("level") == 0);
+        }
+        std::cout << "Stored ordinal: OK" << std::endl;
+    }
+    std::cout << std::endl;
+
+    {
+        std::cout << "[Test Batch Validator]" << std::endl;
+
+        int calls = 0;
+        Command cmd("cmd");
+        cmd.addArgument(Argument("ids").nargs(Argument::Remainder).batch_validate(
+            [&calls](const std::string *tokens, int count, Value *out, std::string *msg) {
+                calls++;
+                for (int i = 0; i < count; ++i) {
+                    if (tokens[i].empty() || tokens[i].front() != 'i') {
+                        *msg = "bad id";
+                        return i;
+                    }
+                    out[i] = tokens[i].substr(1);
+                }
+                return -1;
+            }));
+
+        {
+            Parser parser(cmd);
+            ParseResult res = parser.parse({"cmd", "i1", "i2", "i3"});
+            assert(res.error() == ParseResult::NoError);
+            assert(calls == 1);
+            assert(Value::toStringList(res.values("ids")) ==
+                   std::vector<std::string>({"1", "2", "3"}));
+        }
+        std::cout << "Validate all tokens at once: OK" << std::endl;
+
+        {
+            Parser parser(cmd);
+            ParseResult res = parser.parse({"cmd", "i1", "x", "i3"});
+            assert(res.error() == ParseResult::ArgumentValidateFailed);
+            assert(res.cancellationToken() == "x");
+        }
+        std::cout << "Report failed token: OK" << std::endl;
+    }
+    std::cout << std::endl;
+
+    {
+        std::cout << "[Test Parallel Check]" << std::endl;
+
+        Command cmd("cmd");
+        cmd.addArgument(Argument("ids", {}, true, 0).nargs(Argument::MultiValue));
+
+        std::vector<std::string> args = {"cmd"};
+        for (int i = 0; i < 5000; ++i) {
+            args.push_back(std::to_string(i));
+        }
+
+        Parser parser(cmd);
+        parser.setParallelThreshold(100);
+        {
+            ParseResult res = parser.parse(args);
+            assert(res.error() == ParseResult::NoError);
+            const auto &values = res.values("ids");
+            assert(values.size() == 5000);
+            assert(values[4321] == Value(4321));
+        }
+        std::cout << "Check tokens in parallel: OK" << std::endl;
+
+        args[3000] = "x";
+        args[4000] = "y";
+        {
+            ParseResult res = parser.parse(args);
+            assert(res.error() == ParseResult::ArgumentTypeMismatch);
+            assert(res.cancellationToken() == "x");
+        }
+        std::cout << "Report first failed token: OK" << std::endl;
+
+        Command throwingCmd("cmd");
+        throwingCmd.addArgument(Argument("ids").nargs(Argument::MultiValue).validate(
+            [](const std::string &token, Value *out, std::string *) {
+                if (token == "x")
+                    throw std::runtime_error("bad token");
+                *out = token;
+                return true;
+            }));
+        {
+            Parser throwingParser(throwingCmd);
+            throwingParser.setParallelThreshold(100);
+            bool thrown = false;
+            try {
+                std::ignore = throwingParser.parse(args);
+            } catch (const std::runtime_error &e) {
+                thrown = std::string(e.what()) == "bad token";
+            }
+            assert(thrown);
+        }
+        std::cout << "Rethrow validator exception: OK" << std::endl;
+    }
+    std::cout << std::endl;
+
+    {
+        std::cout << "[Test Value Conversion]" << std::endl;
+
+        assert(Value::fromString("0x1F", Value::Int) == Value(31));
+        assert(Value::fromString("-0b101", Value::Int) == Value(-5));
+        assert(Value::fromString("-2147483648", Value::Int) == Value(-2147483647 - 1));
+        assert(Value::fromString("TRUE", Value::Bool) == Value(true));
+        assert(Value::fromString("+1.5", Value::Double) == Value(1.5));
+        assert(Value::fromString(" \t5", Value::Int) == Value(5));
+        assert(Value::fromString(" -0x10", Value::Int64) == Value(int64_t(-16)));
+        assert(Value::fromString(" -2.5", Value::Double) == Value(-2.5));
+        assert(Value::fromString("0x1p3", Value::Double) == Value(8.0));
+        assert(Value::fromString("-0X1.8p1", Value::Double) == Value(-3.0));
+        std::cout << "Convert valid tokens: OK" << std::endl;
+
+        Value::ConversionError err;
+        size_t pos;
+        assert(Value::fromString("12a", 3, Value::Int, &err, &pos).type() == Value::Null);
+        assert(err == Value::InvalidCharacter && pos == 2);
+        assert(Value::fromString("2147483648", 10, Value::Int, &err, &pos).type() == Value::Null);
+        assert(err == Value::OutOfRange);
+        assert(Value::fromString("", 0, Value::Double, &err, &pos).type() == Value::Null);
+        assert(err == Value::EmptyString);
+        assert(Value::fromString("5 ", 2, Value::Int, &err, &pos).type() == Value::Null);
+        assert(err == Value::InvalidCharacter && pos == 1);
+        assert(Value::fromString("+-1.5", 5, Value::Double, &err, &pos).type() == Value::Null);
+        assert(err == Value::InvalidCharacter && pos == 1);
+        assert(Value::fromString("0x-1p3", 6, Value::Double, &err, &pos).type() == Value::Null);
+        assert(err == Value::InvalidCharacter && pos == 2);
+        std::cout << "Report conversion errors: OK" << std::endl;
     }
     std::cout << std::endl;
 
@@ -91,6 +268,732 @@ int main(int argc, char *argv[]) {
             assert(res.error() == ParseResult::MutuallyExclusiveOptions);
         }
         std::cout << "Mutually exclusive options: OK" << std::endl;
+
+        {
+            Option opt3("--opt3", "3");
+            Option opt4("--opt4", "4");
+            Option opt5("--opt5", "5");
+            opt3.setRequired(true);
+            opt4.setRequired(true);
+            opt5.setRequired(true);
+            cmd.addOption(opt3, "2");
+            cmd.addOption(opt4, "2");
+            cmd.addOption(opt5);
+
+            Parser parser(cmd);
+            ParseResult res = parser.parse({"cmd", "--opt4", "--opt5", "--opt1"});
+            assert(res.error() == ParseResult::NoError);
+
+            res = parser.parse({"cmd", "--opt5"});
+            assert(res.error() == ParseResult::MissingRequiredOption);
+            assert(res.errorText().find("--opt3") != std::string::npos);
+
+            res = parser.parse({"cmd", "--opt3", "--opt4", "--opt5"});
+            assert(res.error() == ParseResult::MutuallyExclusiveOptions);
+        }
+        std::cout << "Required exclusive group: OK" << std::endl;
+    }
+    std::cout << std::endl;
+
+    {
+        std::cout << "[Test Global Option]" << std::endl;
+
+        Command sub("sub");
+        sub.addOption(Option("--local"));
+
+        Command cmd("cmd");
+        cmd.addOption(Option({"--verbose", "-v"}).global());
+        cmd.addCommand(sub);
+
+        {
+            Parser parser(cmd);
+            ParseResult res1 = parser.parse({"cmd", "sub", "-v", "--local"});
+            ParseResult res2 = parser.parse({"cmd", "sub", "--verbose"});
+            assert(res1.error() == ParseResult::NoError);
+            assert(res1.isOptionSet("--verbose") && res1.isOptionSet("--local"));
+            assert(res2.isOptionSet("-v") && !res2.isOptionSet("--local"));
+
+            Command cmd2("cmd");
+            cmd2.addCommand(sub);
+            parser.setRootCommand(cmd2);
+            ParseResult res3 = parser.parse({"cmd", "sub", "-v"});
+            assert(res3.error() == ParseResult::UnknownOption);
+            assert(res1.indexOfOption("-v") == 0);
+        }
+        std::cout << "Inherited options across parses: OK" << std::endl;
+
+        {
+            Command cmd3("cmd");
+            cmd3.addOption(Option("--verbose").global());
+            int fileArg = cmd3.addArgument(Argument("file"));
+            int levelOpt = cmd3.addOption(Option("--level").arg("n"));
+            assert(fileArg == 0 && levelOpt == 1 && cmd3.optionCount() == 2);
+            assert(cmd3.option(levelOpt).token() == "--level");
+
+            Parser parser(cmd3);
+            ParseResult res = parser.parse({"cmd", "a", "--level", "3"});
+            assert(res.value(fileArg) == "a");
+            assert(res.commandOption(levelOpt).value(0) == "3");
+            assert(!res.commandOption(levelOpt + 1).isSet());
+
+            // Global options of the root are reached from a sub-command by their root handle
+            Command sub3("sub");
+            int forceOpt = sub3.addOption(Option("--force"));
+            int verboseOpt = cmd3.addOption(Option({"-V", "--Verbose"}).global());
+            cmd3.addCommand(sub3);
+            parser = Parser(cmd3);
+            res = parser.parse({"cmd", "sub", "--Verbose", "--force"});
+            assert(res.error() == ParseResult::NoError && res.command().name() == "sub");
+            assert(res.rootOption(verboseOpt).isSet() && !res.rootOption(0).isSet());
+            assert(res.rootOption(0).option().token() == "--verbose");
+            assert(res.rootOption(levelOpt).indexOf("n") == -1);
+            assert(res.commandOption(forceOpt).isSet() && !res.commandOption(verboseOpt).isSet());
+            res = parser.parse({"cmd", "x", "--level", "3", "-V"});
+            assert(res.rootOption(levelOpt).value(0) == "3" && res.rootOption(verboseOpt).isSet());
+        }
+        std::cout << "Handle accessors: OK" << std::endl;
+
+        {
+            Command sub2("sub");
+            sub2.addOption(Option("-v").arg("level"));
+            sub2.addOption(Option("-x"));
+            Command cmd4("prog");
+            cmd4.addOption(Option("-v").global());
+            cmd4.addCommand(sub2);
+
+            // The option of the command owns the letter, and it takes an argument
+            Parser parser(cmd4);
+            auto res = parser.parse({"prog", "sub", "-vx"}, Parser::AllowUnixGroupFlags);
+            assert(res.error() == ParseResult::UnknownOption);
+            res = parser.parse({"prog", "-v"}, Parser::AllowUnixGroupFlags);
+            assert(res.error() == ParseResult::NoError && res.isOptionSet("-v"));
+        }
+        std::cout << "Shadowed group flags: OK" << std::endl;
+    }
+    std::cout << std::endl;
+
+    {
+        std::cout << "[Test Repeated Option]" << std::endl;
+
+        {
+            Command cmd4("cmd");
+            cmd4.addOption(Option("-I").arg("dir").multi());
+            cmd4.addOption(Option("-L").arg(Argument("dir").nargs(Argument::MultiValue)));
+
+            Parser parser(cmd4);
+            ParseResult res =
+                parser.parse({"cmd", "-I", "a", "-I", "b", "-L", "c", "d", "-I", "e"});
+            assert(res.error() == ParseResult::NoError);
+
+            std::string joined;
+            for (const auto &item : res.option("-I").allValuesView())
+                joined += item.toString();
+            assert(joined == "abe" && res.option("-I").totalCount() == 3);
+            assert(res.option("-L").allValuesView().toVector().size() == 2);
+            assert(res.option("-L").totalCount() == 2 && res.option("-X").totalCount() == 0);
+            auto empty = res.option("-X").allValuesView();
+            assert(empty.empty() && empty.begin() == empty.end());
+
+            // Counted as values are stored, even if the parse fails
+            res = parser.parse({"cmd", "-I", "a", "-I", "b", "c"}, Parser::CollectAllErrors);
+            assert(res.error() == ParseResult::UnknownCommand);
+            assert(res.option("-I").totalCount() == 2);
+            assert(res.option("-I").allValuesView().size() == 2);
+        }
+        std::cout << "Values of all occurrences: OK" << std::endl;
+    }
+    std::cout << std::endl;
+
+    {
+        std::cout << "[Test Error Text]" << std::endl;
+
+        Command cmd("cmd");
+        cmd.addArgument(Argument("count").default_value(0));
+        cmd.addOption(Option("--once").multi(1));
+        cmd.addOptions({Option("--fast"), Option("--slow")}, "speed");
+
+        Parser parser(cmd);
+        ParseResult res = parser.parse({"cmd", "abc"});
+        assert(res.error() == ParseResult::ArgumentTypeMismatch);
+        assert(res.cancellationToken() == "abc");
+        assert(res.errorText() == R"(Invalid token "abc" of argument "count", expect "int".)");
+
+        res = parser.parse({"cmd", "--once", "--once"});
+        assert(res.error() == ParseResult::OptionOccurTooMuch);
+        assert(res.errorText() == R"(Option "--once" occurs too much, at most 1.)");
+
+        res = parser.parse({"cmd", "--fast", "--slow"});
+        assert(res.errorText() == R"(Options "--fast" and "--slow" are mutually exclusive.)");
+        std::cout << "Format error on demand: OK" << std::endl;
+
+        {
+            Command cmd2("cmd");
+            cmd2.addArgument(Argument("count").default_value(0));
+            cmd2.addOption(Option("--level").arg(Argument("n").default_value(0)));
+            cmd2.addOption(Option("--name").arg("name").required());
+            cmd2.addOptions({Option("--fast"), Option("--slow")}, "speed");
+
+            Parser parser2(cmd2);
+            const auto &args = std::vector<std::string>{
+                "cmd", "x", "--fast", "--level", "y", "--slow", "--bad", "extra",
+            };
+            ParseResult res2 = parser2.parse(args, Parser::CollectAllErrors);
+            assert(res2.error() == ParseResult::ArgumentTypeMismatch);
+            assert(res2.errorCount() == 6);
+            assert(res2.errorAt(1) == ParseResult::ArgumentTypeMismatch);
+            assert(res2.errorAt(2) == ParseResult::MutuallyExclusiveOptions);
+            assert(res2.errorAt(3) == ParseResult::UnknownOption);
+            assert(res2.errorAt(4) == ParseResult::TooManyArguments);
+            assert(res2.errorAt(5) == ParseResult::MissingRequiredOption);
+            assert(res2.errorTextAt(3) == R"(Unknown option "--bad".)");
+            assert(res2.errorAt(6) == ParseResult::NoError);
+
+            res2 = parser2.parse(args);
+            assert(res2.errorCount() == 1 && res2.error() == ParseResult::ArgumentTypeMismatch);
+        }
+        std::cout << "Collect all errors: OK" << std::endl;
+    }
+    std::cout << std::endl;
+
+    {
+        std::cout << "[Test Parse Session]" << std::endl;
+
+        Command cmd("cmd");
+        cmd.addArgument(Argument("files").nargs(Argument::MultiValue));
+        cmd.addOption(Option("-I").arg("dir").multi());
+
+        ParseSession session(Parser{cmd});
+        ParseResult kept = session.parse({"cmd", "a", "-I", "x"});
+        for (int i = 0; i < 3; ++i) {
+            ParseResult res = session.parse({"cmd", "b", "c", "-I", "y", "-I", "z"});
+            assert(res.error() == ParseResult::NoError);
+            assert(res.values("files").size() == 2 && res.option("-I").totalCount() == 2);
+            assert(res.arguments().size() == 7 && res.arguments()[2] == "c");
+        }
+        ParseResult res = session.parse({"cmd"});
+        assert(res.error() == ParseResult::MissingCommandArgument);
+        assert(res.values("files").empty() && !res.isOptionSet("-I"));
+        assert(res.arguments() == std::vector<std::string>{"cmd"});
+        assert(kept.value("files") == "a" && kept.option("-I").value() == "x");
+        assert(kept.arguments().size() == 4 && kept.arguments()[3] == "x");
+        std::cout << "Reuse buffers across parses: OK" << std::endl;
+
+        auto responsePath = std::filesystem::temp_directory_path() / "syscmdline_response.txt";
+        std::ofstream(responsePath) << "d\ne\n";
+        const std::string responseArg = "@" + responsePath.string();
+        res = session.parse({"cmd", responseArg}, Parser::EnableResponseFile);
+        std::filesystem::remove(responsePath);
+        assert(res.error() == ParseResult::NoError && res.values("files").size() == 2);
+        assert(res.arguments() == (std::vector<std::string>{"cmd", responseArg}));
+        std::cout << "Keep input arguments: OK" << std::endl;
+    }
+    std::cout << std::endl;
+
+    {
+        std::cout << "[Test Parse Events]" << std::endl;
+
+        struct Counter : public Parser::Visitor {
+            std::string symbols;
+            int errors = 0;
+
+            void onCommand(const Command &command) override {
+                symbols += command.name() + ";";
+            }
+            void onOption(const Option &option, int occurrence) override {
+                symbols += option.token() + std::to_string(occurrence) + ";";
+            }
+            void onArgument(const Argument & /*argument*/, const Value &value,
+                            const Option *option) override {
+                symbols += (option ? "opt:" : "") + value.toString() + ";";
+            }
+            void onError(ParseResult::Error /*error*/, const std::string & /*token*/) override {
+                errors++;
+            }
+        };
+
+        int jobs = 0;
+        Command build("build");
+        build.addArgument(Argument("files").nargs(Argument::MultiValue));
+        build.addArgument(Argument("out"));
+        build.addOption(Option("-j").arg(Argument("n").bind(jobs)));
+        build.addOption(Option("-v").multi());
+
+        Command cmd("cmd");
+        cmd.addCommand(build);
+
+        Parser parser(cmd);
+        Counter counter;
+        auto err = parser.parseEvents({"cmd", "build", "a", "-v", "-j", "4", "-v", "b", "c"},
+                                      counter);
+        assert(err == ParseResult::NoError && counter.errors == 0 && jobs == 0);
+        assert(counter.symbols == "cmd;build;-v0;-j0;opt:4;-v1;c;a;b;");
+
+        counter = {};
+        err = parser.parseEvents({"cmd", "build", "a", "-j", "x"}, counter);
+        assert(err == ParseResult::ArgumentTypeMismatch && counter.errors == 1);
+        std::cout << "Report symbols without result: OK" << std::endl;
+    }
+    std::cout << std::endl;
+
+    {
+        std::cout << "[Test GetOptLong]" << std::endl;
+
+        int all = 0;
+        const GetOptLong::LongOption longopts[] = {
+            {"output", GetOptLong::RequiredArgument, nullptr, 'o'},
+            {"all", GetOptLong::NoArgument, &all, 1},
+            {"color", GetOptLong::OptionalArgument, nullptr, 'c'},
+            {nullptr, 0, nullptr, 0},
+        };
+        GetOptLong getopt("ls", "lo:v", longopts);
+
+        std::vector<std::string> tokens = {
+            "ls",           "a",  "-lvofile", "b", "--out", "x", "--all",
+            "--color=auto", "-o", "y",        "--", "-v",
+        };
+        std::vector<char *> argv;
+        for (auto &token : tokens)
+            argv.push_back(token.data());
+
+        std::string seen;
+        int ch, index = -1;
+        while ((ch = getopt.next(int(argv.size()), argv.data(), &index)) != -1) {
+            seen += char(ch ? ch : '0');
+            if (getopt.optarg())
+                seen += std::string("=") + getopt.optarg();
+            seen += ";";
+        }
+        assert(seen == "l;v;o=file;o=x;0;c=auto;o=y;" && all == 1 && index == 2);
+        assert(std::string(argv[getopt.optind()]) == "a" && argv.size() - getopt.optind() == 3);
+        assert(std::string(argv.back()) == "-v");
+
+        getopt.reset();
+        char arg0[] = "ls", arg1[] = "--col", arg2[] = "-x", arg3[] = "-o";
+        char *argv2[] = {arg0, arg1, arg2, arg3};
+        assert(getopt.next(4, argv2) == 'c' && getopt.optarg() == nullptr);
+        assert(getopt.next(4, argv2) == '?' && getopt.optopt() == 'x');
+        assert(getopt.errorText() == R"(Unknown option "-x".)");
+        assert(getopt.next(4, argv2) == '?' &&
+               getopt.error() == ParseResult::MissingOptionArgument);
+        assert(getopt.next(4, argv2) == -1);
+        assert(getopt.command().optionCount() == 6);
+        std::cout << "Iterate as getopt_long: OK" << std::endl;
+    }
+    std::cout << std::endl;
+
+    {
+        std::cout << "[Test Schema Cache]" << std::endl;
+
+        Command commit("commit", "Record changes");
+        commit.addArgument(Argument("paths").nargs(Argument::MultiValue).required(false));
+        commit.addOption(Option({"-m", "--message"}, "Message", Argument("msg")).multi());
+        commit.addOptions({Option("--fast"), Option("--slow")}, "speed");
+        commit.addOption(
+            Option("--mode").arg(Argument("mode").expect({"a", "b"}).default_value("a")));
+        commit.addOption(Option("--level").arg(Argument("n").default_value(2)).global());
+
+        Command cmd("cmd", "Tool");
+        cmd.addCommand(commit);
+        cmd.addOption(Option("--ratio").arg(Argument("r").default_value(0.5)).short_match());
+        CommandCatalogue catalogue;
+        catalogue.addCommands("Main", {"commit"});
+        cmd.setCatalogue(catalogue);
+        cmd.addVersionOption("1.0");
+        cmd.addHelpOption(true, true);
+
+        auto path = std::filesystem::temp_directory_path() / "tst_basic.schema";
+        auto key = SchemaCache::fingerprint("1.0");
+        assert(SchemaCache::save(cmd, path.string(), key));
+
+        Command loaded;
+        std::vector<std::string> handled;
+        const auto &provider = [&handled](const std::vector<std::string> &path) {
+            handled.push_back(path.back());
+            return Command::Handler();
+        };
+        assert(!SchemaCache::load(path.string(), key + 1, &loaded));
+        assert(SchemaCache::load(path.string(), key, &loaded, provider));
+        assert((handled == std::vector<std::string>{"cmd", "commit"}));
+
+        assert(loaded.helpText(Symbol::HP_Usage, 0) == cmd.helpText(Symbol::HP_Usage, 0));
+        assert(loaded.command(0).helpText(Symbol::HP_Usage, Parser::ShowOptionalOptionsOnUsage) ==
+               commit.helpText(Symbol::HP_Usage, Parser::ShowOptionalOptionsOnUsage));
+        assert(loaded.versionString() == "1.0");
+
+        Parser parser(loaded);
+        auto res = parser.parse({"cmd", "commit", "-m", "x", "--fast", "--mode", "b", "--slow"});
+        assert(res.error() == ParseResult::MutuallyExclusiveOptions);
+        res = parser.parse({"cmd", "commit", "-m", "x", "--mode", "b", "p1", "p2"});
+        assert(res.error() == ParseResult::NoError);
+        assert(res.option("--mode").value() == "b" && res.option("--level").value() == 2);
+        assert(res.values("paths").size() == 2);
+        res = parser.parse({"cmd", "--ratio0.25"});
+        assert(res.option("--ratio").value().toString() == "0.25");
+        std::cout << "Save and load command tree: OK" << std::endl;
+
+        // A broken image is rejected or gives some valid tree, it never crashes
+        std::string image;
+        {
+            std::ifstream file(path, std::ios::binary);
+            image.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        }
+        auto brokenPath = std::filesystem::temp_directory_path() / "tst_basic_broken.schema";
+        int rejected = 0;
+        for (size_t i = 0; i < image.size(); ++i) {
+            auto broken = image;
+            broken[i] = char(0xFF);
+            std::ofstream(brokenPath, std::ios::binary | std::ios::trunc) << broken;
+
+            Command brokenCmd;
+            if (!SchemaCache::load(brokenPath.string(), key, &brokenCmd)) {
+                rejected++;
+                continue;
+            }
+            std::ignore = brokenCmd.helpText(Symbol::HP_Usage, 0);
+            std::ignore = brokenCmd.description() + brokenCmd.detailedDescription();
+        }
+        assert(rejected > 0);
+        std::filesystem::remove(brokenPath);
+        std::filesystem::remove(path);
+        std::cout << "Reject broken image: OK" << std::endl;
+    }
+    std::cout << std::endl;
+
+    {
+        std::cout << "[Test Json Schema]" << std::endl;
+
+        const char *json = R"({
+            "name": "cmd",
+            "description": "Tool \u00e9",
+            "options": [
+                {"role": "Help", "prior": "IgnoreMissingSymbols", "global": true},
+                {"token": "--ratio", "shortMatch": "ShortMatchAll",
+                 "arguments": [{"name": "r", "default": 0.5}]}
+            ],
+            "commands": [{
+                "arguments": [{"name": "paths", "number": "MultiValue", "required": false}],
+                "options": [
+                    {"tokens": ["-m", "--message"], "maxOccurrence": 0,
+                     "arguments": [{"name": "msg"}]},
+                    {"token": "--fast", "group": "speed"},
+                    {"token": "--slow", "group": "speed"},
+                    {"token": "--mode", "arguments": [
+                        {"name": "mode", "expectedValues": ["a", "b"], "default": "a"}]}
+                ],
+                "name": "commit",
+                "x-unknown": {"nested": [1, 2, null]}
+            }],
+            "catalogue": {"commands": {"Main": ["commit"]}}
+        })";
+
+        Command cmd;
+        std::vector<std::string> handled;
+        const auto &provider = [&handled](const std::vector<std::string> &path) {
+            handled.push_back(path.back());
+            return Command::Handler();
+        };
+        assert(JsonSchema::load(json, &cmd, nullptr, provider));
+        assert((handled == std::vector<std::string>{"cmd", "commit"}));
+        assert(cmd.description() == "Tool \xc3\xa9" && cmd.command(0).name() == "commit");
+
+        Parser parser(cmd);
+        auto res = parser.parse({"cmd", "commit", "--fast", "--slow"});
+        assert(res.error() == ParseResult::MutuallyExclusiveOptions);
+        res = parser.parse({"cmd", "commit", "-m", "x", "-m", "y", "--mode", "c"});
+        assert(res.error() == ParseResult::InvalidArgumentValue);
+        res = parser.parse({"cmd", "commit", "-m", "x", "-m", "y", "p"});
+        assert(res.error() == ParseResult::NoError && res.option("-m").count() == 2);
+        assert(res.option("--mode").value() == "a" && res.value("paths") == "p");
+        assert(parser.parse({"cmd", "commit", "-h"}).isHelpSet());
+
+        std::string errorMessage;
+        const char *badJson = "{\"name\": \"cmd\",\n \"options\": [{\"role\": \"Helps\"}]}";
+        assert(!JsonSchema::load(badJson, &cmd, &errorMessage));
+        assert(errorMessage == R"(2:30: unknown enumerator "Helps")");
+        std::cout << "Load command tree from JSON: OK" << std::endl;
+
+        // Checked in every build type, failures are reported instead of being thrown
+        const char *const invalidSchemas[] = {
+            R"({"arguments": [{"name": "a"}, {"name": "a"}]})",
+            R"({"options": [{"token": "-a"}, {"token": "-a"}]})",
+            R"({"options": [{"token": "a"}]})",
+            R"({"commands": [{"name": "x"}, {"name": "x"}]})",
+            R"({"catalogue": {"options": {"Main": ["-a", "-a"]}}})",
+        };
+        for (const auto &schema : invalidSchemas) {
+            errorMessage.clear();
+            assert(!JsonSchema::load(schema, &cmd, &errorMessage) && !errorMessage.empty());
+        }
+        assert(!JsonSchema::load(invalidSchemas[1], &cmd, &errorMessage));
+        assert(errorMessage == R"(1:46: option token "-a" duplicated)");
+        std::cout << "Reject invalid symbols: OK" << std::endl;
+
+        const char *const malformedJsons[] = {
+            R"({"name": "cmd", "x": +5})",
+            R"({"name": "cmd", "x": 0123})",
+            R"({"name": "cmd", "x": 1.})",
+            R"({"name": "cmd", "x": -})",
+            R"({"name": "cmd", "x": 1e})",
+            "{\"name\": \"c\tmd\"}",
+            R"({"name": "\x"})",
+        };
+        for (const auto &malformed : malformedJsons) {
+            assert(!JsonSchema::load(malformed, &cmd, &errorMessage));
+        }
+        assert(JsonSchema::load(R"({"name": "cmd", "x": [-0, 0.5e+3, 10, -1E-2]})", &cmd));
+
+        std::string deep = R"({"name": "cmd", "x": )";
+        for (int i = 0; i < 100000; ++i)
+            deep += '[';
+        assert(!JsonSchema::load(deep, &cmd, &errorMessage));
+        assert(errorMessage.find("too deeply nested") != std::string::npos);
+        std::cout << "Reject malformed JSON: OK" << std::endl;
+    }
+    std::cout << std::endl;
+
+    {
+        std::cout << "[Test Lazy Command]" << std::endl;
+
+        int commitBuilt = 0;
+        int remoteBuilt = 0;
+        Command cmd("git");
+        cmd.addLazyCommand("commit", "Record changes", [&commitBuilt]() {
+            ++commitBuilt;
+            Command commit("commit");
+            commit.addOption(Option({"-m", "--message"}, {}, {Argument("msg")}));
+            commit.addArgument(Argument("paths", {}, false).nargs(Argument::MultiValue));
+            return commit;
+        });
+        cmd.addLazyCommand("remote", "Manage remotes", [&remoteBuilt]() {
+            ++remoteBuilt;
+            return Command("remote", "Another description", {Argument("name")});
+        });
+        cmd.addLazyCommand("tag", "Create tags", []() {
+            Command tag("tag");
+            tag.setHelpProvider([](const Symbol *, Symbol::HelpPosition pos, int, void *) {
+                return pos == Symbol::HP_Usage ? std::string("tag <name>") : std::string();
+            });
+            return tag;
+        });
+        cmd.addHelpOption(false, true);
+
+        assert(cmd.commandCount() == 3);
+        assert(cmd.helpText(Symbol::HP_Usage, 0) == "git [command] [options]");
+        assert(commitBuilt == 0 && remoteBuilt == 0);
+
+        Parser parser(cmd);
+        auto res = parser.parse({"git", "commit", "-m", "x", "a", "b"});
+        assert(res.error() == ParseResult::NoError && res.command().name() == "commit");
+        assert(res.valueForOption("-m") == "x" && res.values("paths").size() == 2);
+        assert(parser.parse({"git", "commit", "-h"}).isHelpSet());
+        assert(parser.parse({"git", "status"}).error() == ParseResult::UnknownCommand);
+        assert(commitBuilt == 1 && remoteBuilt == 0);
+
+        // The placeholder keeps its own name and description
+        auto remote = cmd.command(1);
+        assert(remoteBuilt == 1 && remote.description() == "Manage remotes");
+        assert(remote.argumentCount() == 1 && cmd.command(1).argumentCount() == 1);
+        assert(remoteBuilt == 1 && commitBuilt == 1);
+
+        // The factory's help provider comes along with the rest
+        assert(cmd.command(2).helpText(Symbol::HP_Usage, 0) == "tag <name>");
+        std::cout << "Build sub-commands on demand: OK" << std::endl;
+    }
+    std::cout << std::endl;
+
+#ifdef TEST_PLUGIN_PATH
+    {
+        std::cout << "[Test Plugin Registry]" << std::endl;
+
+        auto dir = std::filesystem::temp_directory_path() / "syscmdline_tst_plugins";
+        std::filesystem::create_directories(dir);
+        {
+            std::ofstream manifest(dir / "plugins.json");
+            manifest << R"({"plugins": [{"name": "push", "description": "Update remote", )"
+                     << R"("library": ")" << TEST_PLUGIN_PATH << R"("}, )"
+                     << R"({"name": "broken", "library": "missing.so"}]})";
+        }
+
+        Command cmd("git");
+        std::string errorMessage;
+        assert(!PluginRegistry::scan((dir / "none").string(), &cmd, &errorMessage));
+        assert(PluginRegistry::scan(dir.string(), &cmd, &errorMessage));
+        assert(cmd.commandCount() == 2);
+
+        // Taken names reject the whole manifest
+        assert(!PluginRegistry::scan(dir.string(), &cmd, &errorMessage));
+        assert(errorMessage == "plugin name \"push\" duplicated" && cmd.commandCount() == 2);
+        {
+            auto twiceDir = dir / "twice";
+            std::filesystem::create_directories(twiceDir);
+            std::ofstream(twiceDir / "plugins.json")
+                << R"({"plugins": [{"name": "a", "library": "a.so"}, )"
+                << R"({"name": "b", "library": "b.so"}, {"name": "a", "library": "c.so"}]})";
+            Command other("git");
+            assert(!PluginRegistry::scan(twiceDir.string(), &other, &errorMessage));
+            assert(errorMessage == "plugin name \"a\" duplicated" && other.commandCount() == 0);
+        }
+
+        Parser parser(cmd);
+        auto res = parser.parse({"git", "push", "origin", "--force"});
+        assert(res.error() == ParseResult::NoError && res.command().name() == "push");
+        assert(res.command().description() == "Update remote");
+        assert(res.value("remote") == "origin" && res.option("--force").isSet());
+        assert(res.invoke() == 42);
+        assert(parser.parse({"git", "broken", "a", "--b"}).error() == ParseResult::NoError);
+
+        std::filesystem::remove_all(dir);
+        std::cout << "Load plugins on demand: OK" << std::endl;
+    }
+    std::cout << std::endl;
+#endif
+
+    {
+        std::cout << "[Test Compressed Description]" << std::endl;
+
+        std::string prose;
+        for (int i = 0; i < 50; ++i) {
+            prose += "Record changes to the repository, entry " + std::to_string(i) + ". ";
+        }
+        const std::string texts[] = {
+            {},
+            "Short",
+            std::string(1000, 'a') + "b" + std::string(70000, 'c'),
+            prose,
+            "\xc3\xa9\t\n" + prose.substr(0, 40) + std::string(3, '\0') + prose.substr(20, 40),
+        };
+        for (const auto &text : texts) {
+            Command cmd("cmd", text);
+            cmd.setDetailedDescription(text + text);
+            assert(cmd.description() == text && cmd.detailedDescription() == text + text);
+            Option opt("--opt", text);
+            assert(opt.description() == text);
+        }
+        std::cout << "Decode descriptions on demand: OK" << std::endl;
+    }
+    std::cout << std::endl;
+
+    {
+        std::cout << "[Test Exclusive Group Names]" << std::endl;
+
+        // The same group name in different commands stays independent
+        Command sub("sub");
+        sub.addOptions({Option("--fast"), Option("--quiet")}, "speed");
+        Command cmd("cmd");
+        cmd.addOptions({Option("--fast"), Option("--slow")}, "speed");
+        cmd.addOption(Option("--quiet"));
+        cmd.addOptions({Option("--a", {}, {}, true), Option("--b", {}, {}, true)}, "ab");
+        cmd.addCommand(sub);
+        assert(cmd.helpText(Symbol::HP_Usage, Parser::ShowOptionalOptionsOnUsage) ==
+               "cmd (--a | --b) [--fast | --slow] [--quiet] [command] [options]");
+
+        Parser parser(cmd);
+        assert(parser.parse({"cmd", "--a", "--fast", "--quiet"}).error() == ParseResult::NoError);
+        assert(parser.parse({"cmd", "--a", "--fast", "--slow"}).error() ==
+               ParseResult::MutuallyExclusiveOptions);
+        assert(parser.parse({"cmd", "sub", "--fast", "--quiet"}).error() ==
+               ParseResult::MutuallyExclusiveOptions);
+        std::cout << "Keep group names per command: OK" << std::endl;
+    }
+    std::cout << std::endl;
+
+    {
+        std::cout << "[Test Binding]" << std::endl;
+
+        int jobs = 0;
+        bool verbose = false;
+        std::vector<std::string> files;
+
+        Command cmd("cmd");
+        cmd.addOptions({
+            Option("-j", "jobs", Argument("n").bind(jobs)),
+            Option("-V").bind(verbose),
+        });
+        cmd.addArgument(Argument("files").nargs(Argument::MultiValue).bind(files));
+
+        {
+            Parser parser(cmd);
+            ParseResult res = parser.parse({"cmd", "a", "b", "-j", "0x10", "-V"});
+            assert(res.error() == ParseResult::NoError);
+            assert(jobs == 16);
+            assert(verbose);
+            assert(files == std::vector<std::string>({"a", "b"}));
+            assert(res.values("files").empty());
+        }
+        std::cout << "Bind storage: OK" << std::endl;
+
+        {
+            int n = 0;
+            std::vector<int> xs;
+            std::vector<std::string> names = {"old"};
+            Command cmd2("prog");
+            cmd2.addArgument(Argument("n").bind(n));
+            cmd2.addArgument(Argument("xs").nargs(Argument::MultiValue).bind(xs));
+            cmd2.addOption(Option("-N").arg(Argument("name").bind(names)).multi());
+
+            // Every parse replaces what the lists got before
+            ParseSession session(Parser{cmd2});
+            for (int i = 0; i < 2; ++i) {
+                auto res = session.parse({"prog", "7", "1", "2", "-N", "a", "-N", "b"});
+                assert(res.error() == ParseResult::NoError);
+                assert(n == 7 && xs == std::vector<int>({1, 2}));
+                assert(names == std::vector<std::string>({"a", "b"}));
+            }
+        }
+        std::cout << "Replace bound lists: OK" << std::endl;
+
+        {
+            jobs = 0;
+            verbose = false;
+            files.clear();
+            Parser parser(cmd);
+            ParseResult res = parser.parse({"cmd", "a", "-V", "-j", "x"});
+            assert(res.error() == ParseResult::ArgumentTypeMismatch);
+            assert(jobs == 0 && !verbose && files.empty());
+        }
+        std::cout << "Bound type mismatch: OK" << std::endl;
+
+        {
+            int level = 0;
+            std::string name = "x";
+            Command cmd3("cmd");
+            cmd3.addOption(Option("-l", {}, Argument("level", {}, true, 3).bind(level)));
+            cmd3.addArgument(Argument("name", {}, false, "def").bind(name));
+
+            Parser parser(cmd3);
+            assert(parser.parse({"cmd"}).error() == ParseResult::NoError);
+            assert(level == 3 && name == "def");
+            assert(parser.parse({"cmd", "-l", "5", "n"}).error() == ParseResult::NoError);
+            assert(level == 5 && name == "n");
+        }
+        std::cout << "Bind default values: OK" << std::endl;
+
+        std::vector<double> weights;
+        Command cmd2("cmd");
+        cmd2.addOption(
+            Option("--weights").arg(Argument("w").nargs(Argument::MultiValue).bind(weights)));
+
+        {
+            Parser parser(cmd2);
+            ParseResult res = parser.parse({"cmd", "--weights", "0.5", "1", "-2e1"});
+            assert(res.error() == ParseResult::NoError);
+            assert(weights == std::vector<double>({0.5, 1, -20}));
+        }
+        std::cout << "Bind numeric array: OK" << std::endl;
+
+        {
+            Parser parser(cmd2);
+            weights.clear();
+            ParseResult res = parser.parse({"cmd", "--weights", "0.5", "abc"});
+            assert(res.error() == ParseResult::ArgumentTypeMismatch);
+            assert(res.cancellationToken() == "abc");
+            assert(weights.empty());
+
+            res = parser.parse({"cmd", "--weights", "x", "1", "y"}, Parser::CollectAllErrors);
+            assert(res.errorCount() == 2 && res.errorAt(1) == ParseResult::ArgumentTypeMismatch);
+            assert(weights.empty());
+        }
+        std::cout << "Bound numeric array mismatch: OK" << std::endl;
     }
     std::cout << std::endl;
 
@@ -0,0 +1,11 @@
+#include <syscmdline/command.h>
+
+using namespace SysCmdLine;
+
+extern "C" SYSCMDLINE_DECL_EXPORT void syscmdline_plugin_command(Command *command) {
+    command->addArgument(Argument("remote"));
+    command->addOption(Option("--force"));
+    command->setHandler([](const ParseResult &) {
+        return 42; //
+    });
+}